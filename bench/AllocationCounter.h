@@ -0,0 +1,46 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief Counts heap allocations of a benchmark executable.
+ *
+ * Defines the replacement global operator new and operator delete, which cannot be
+ * inline, so include it from the one source file of each executable that counts
+ * allocations.
+ */
+namespace bench {
+    /** @brief Global operator new calls since the program started. */
+    inline std::atomic<std::size_t> allocations{0};
+
+    /**
+     * @brief Runs fn and returns how many global operator new calls it made.
+     */
+    template<typename Fn>
+    std::size_t countAllocations(Fn &&fn) {
+        const std::size_t before = allocations.load();
+        fn();
+        return allocations.load() - before;
+    }
+}
+
+void *operator new(const std::size_t size) {
+    bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#endif //ALLOCATIONCOUNTER_H
@@ -0,0 +1,157 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Minimal self-contained timing helpers shared by the benchmark executables.
+ *
+ * Kept dependency-free on purpose so the benchmarks build anywhere the client builds.
+ */
+namespace bench {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Summary of a set of samples, all values in nanoseconds.
+     */
+    struct Stats {
+        std::size_t count = 0;
+        double mean = 0;
+        double p50 = 0;
+        double p99 = 0;
+        double max = 0;
+    };
+
+    /**
+     * @brief Computes mean and percentiles of the given samples.
+     * @param samples Samples in nanoseconds. Sorted in place.
+     * @return The summary.
+     */
+    inline Stats summarize(std::vector<double> &samples) {
+        Stats s;
+        if (samples.empty()) return s;
+        std::sort(samples.begin(), samples.end());
+        double sum = 0;
+        for (const double v: samples) sum += v;
+        s.count = samples.size();
+        s.mean = sum / static_cast<double>(samples.size());
+        s.p50 = samples[samples.size() / 2];
+        s.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        s.max = samples.back();
+        return s;
+    }
+
+    /**
+     * @brief Elapsed time between two clock readings in nanoseconds.
+     */
+    inline double nanosBetween(const Clock::time_point from, const Clock::time_point to) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+    }
+
+    /**
+     * @brief Runs fn repeatedly and returns the mean nanoseconds per call.
+     * @param iterations Number of timed calls.
+     * @param fn The function under test.
+     */
+    template<typename Fn>
+    double timePerCall(const std::size_t iterations, Fn &&fn) {
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+        return nanosBetween(start, Clock::now()) / static_cast<double>(iterations);
+    }
+
+    inline void printStats(const std::string &label, const Stats &s) {
+        std::printf("%-40s n=%-8zu mean=%10.0fns p50=%10.0fns p99=%10.0fns max=%10.0fns\n",
+                    label.c_str(), s.count, s.mean, s.p50, s.p99, s.max);
+    }
+
+    /**
+     * @brief One named measurement of a Suite; times in nanoseconds per operation.
+     */
+    struct Result {
+        std::string name;
+        std::size_t operations = 0;
+        Stats perOperation; ///< Summary over the batches, each batch averaged per operation.
+    };
+
+    /**
+     * @brief Runs named cases, prints them and keeps the results for writeJson.
+     *
+     * Each case is timed in batches; a batch's time divided by its operations is one
+     * sample, so p50 and p99 show the spread between batches rather than of single
+     * calls too short to time.
+     */
+    class Suite {
+        std::string filter;
+        std::vector<Result> results;
+
+    public:
+        /**
+         * @param filter Only cases whose name contains it are run; empty runs all.
+         */
+        explicit Suite(std::string filter = {}) : filter(std::move(filter)) {}
+
+        [[nodiscard]] bool selected(const std::string &name) const {
+            return filter.empty() || name.find(filter) != std::string::npos;
+        }
+
+        /**
+         * @brief Times fn, which performs operationsPerCall operations per call.
+         * @param name Unique name of the case, used to match results across runs.
+         * @param calls Number of timed calls in total, split into batches.
+         * @param fn The code under test.
+         * @param operationsPerCall Operations one call stands for, e.g. the items a queue case moves.
+         */
+        template<typename Fn>
+        void run(const std::string &name, const std::size_t calls, Fn &&fn, const std::size_t operationsPerCall = 1) {
+            if (!selected(name)) return;
+            constexpr std::size_t Batches = 25;
+            const std::size_t perBatch = std::max<std::size_t>(1, calls / Batches);
+            fn(); // warm-up
+            std::vector<double> samples;
+            samples.reserve(Batches);
+            for (std::size_t b = 0; b < Batches; ++b) {
+                samples.push_back(timePerCall(perBatch, fn) / static_cast<double>(operationsPerCall));
+            }
+            record(name, perBatch * Batches * operationsPerCall, summarize(samples));
+        }
+
+        /**
+         * @brief Stores a result measured by the caller, e.g. across several threads.
+         */
+        void record(const std::string &name, const std::size_t operations, const Stats &perOperation) {
+            results.push_back({name, operations, perOperation});
+            std::printf("%-44s %12.1fns/op  p50=%12.1fns  p99=%12.1fns\n", name.c_str(), perOperation.mean,
+                        perOperation.p50, perOperation.p99);
+        }
+
+        [[nodiscard]] const std::vector<Result> &getResults() const { return results; }
+
+        /**
+         * @brief Writes all results as {"results": [{"name", "operations", "mean_ns", "p50_ns", "p99_ns", "max_ns"}]}.
+         * @return False if the file could not be written.
+         */
+        bool writeJson(const std::string &path) const {
+            std::FILE *file = std::fopen(path.c_str(), "w");
+            if (!file) return false;
+            std::fprintf(file, "{\"results\": [\n");
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                const Result &r = results[i];
+                std::fprintf(file, "  {\"name\": \"%s\", \"operations\": %zu, \"mean_ns\": %.2f, \"p50_ns\": %.2f, "
+                                   "\"p99_ns\": %.2f, \"max_ns\": %.2f}%s\n",
+                             r.name.c_str(), r.operations, r.perOperation.mean, r.perOperation.p50,
+                             r.perOperation.p99, r.perOperation.max, i + 1 < results.size() ? "," : "");
+            }
+            std::fprintf(file, "]}\n");
+            return std::fclose(file) == 0;
+        }
+    };
+}
+
+#endif //BENCHHARNESS_H
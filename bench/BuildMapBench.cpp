@@ -0,0 +1,209 @@
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ftxui/dom/elements.hpp>
+#include <ftxui/screen/screen.hpp>
+
+#include "BenchHarness.h"
+#include "game/GameState.h"
+#include "ui/TuiRenderer.h"
+
+using namespace ftxui;
+
+/**
+ * TuiRenderer::buildMap on a 154x40 viewport with a few NPCs, objects and players,
+ * against the previous implementation kept below as the reference: split_utf8 on
+ * every visible row and one text element per cell, every frame.
+ *
+ * Reports element construction alone and construction plus layout and drawing into
+ * an offscreen Screen. Both versions must draw the same screen, otherwise the
+ * executable exits with a non-zero status.
+ */
+namespace {
+    constexpr int RangeX = 77;
+    constexpr int RangeY = 20;
+    constexpr int MapMaxWidth = 154;
+    constexpr int MapMaxHeightNoLogs = 40;
+
+    using Layers = std::map<std::string, std::vector<std::string> >;
+
+    std::vector<std::string> legacySplitUtf8(const std::string &str) {
+        std::vector<std::string> chars;
+        for (size_t i = 0; i < str.length();) {
+            int cplen = 1;
+            const auto c = static_cast<unsigned char>(str[i]);
+            if ((c & 0xF8) == 0xF0) cplen = 4;
+            else if ((c & 0xF0) == 0xE0) cplen = 3;
+            else if ((c & 0xE0) == 0xC0) cplen = 2;
+
+            if (i + cplen > str.length()) cplen = 1;
+            chars.push_back(str.substr(i, cplen));
+            i += cplen;
+        }
+        return chars;
+    }
+
+    /** @brief buildMap as it was before the tile grid. */
+    Element legacyBuildMap(const GameState &state, const Layers &layers) {
+        const int height = std::min(state.map.rangeY * 2 + 1, MapMaxHeightNoLogs);
+        const int width = std::min(state.map.rangeX * 2 + 1, MapMaxWidth);
+        const int clientTopLeftX = state.map.centerX - (width / 2);
+        const int clientTopLeftY = state.map.centerY - (height / 2);
+        const int offsetX = clientTopLeftX - (state.map.centerX - state.map.rangeX);
+        const int offsetY = clientTopLeftY - (state.map.centerY - state.map.rangeY);
+
+        std::vector display_grid(height, std::vector<std::string>(width, " "));
+        const auto &rows = layers.at(std::to_string(state.map.centerZ));
+        for (int y = 0; y < height; ++y) {
+            const int serverY = y + offsetY;
+            if (serverY >= 0 && serverY < static_cast<int>(rows.size())) {
+                std::vector<std::string> row_chars = legacySplitUtf8(rows[serverY]);
+                for (int x = 0; x < width; ++x) {
+                    const int serverX = x + offsetX;
+                    if (serverX >= 0 && serverX < static_cast<int>(row_chars.size()) && row_chars[serverX] != " ") {
+                        display_grid[y][x] = row_chars[serverX];
+                    }
+                }
+            }
+        }
+
+        for (const auto &obj: state.objects) {
+            const int relX = obj.x - clientTopLeftX;
+            const int relY = obj.y - clientTopLeftY;
+            if (relY >= 0 && relY < height && relX >= 0 && relX < width) {
+                display_grid[relY][relX] = obj.type == "CONTAINER" ? "■" : obj.type == "EXIT" ? ">" : "=";
+            }
+        }
+        for (const auto &npc: state.npcs) {
+            const int relX = npc.x - clientTopLeftX;
+            const int relY = npc.y - clientTopLeftY;
+            if (relY >= 0 && relY < height && relX >= 0 && relX < width) {
+                display_grid[relY][relX] = npc.aggressive ? "M" : npc.interaction == "TRADE" ? "T" : "N";
+            }
+        }
+        for (const auto &other: state.otherPlayers) {
+            const int relX = other.x - clientTopLeftX;
+            const int relY = other.y - clientTopLeftY;
+            if (relY >= 0 && relY < height && relX >= 0 && relX < width) display_grid[relY][relX] = "P";
+        }
+        display_grid[state.player.y - clientTopLeftY][state.player.x - clientTopLeftX] = "@";
+
+        Elements rows_elements;
+        for (const auto &row_vec: display_grid) {
+            Elements line_elems;
+            for (const auto &cell: row_vec) {
+                auto t = text(cell);
+                if (cell == "@") t = t | color(Color::GreenLight) | bold;
+                else if (cell == "P") t |= color(Color::BlueLight) | bold;
+                else if (cell == "M") t |= color(Color::Red) | bold;
+                else if (cell == "N") t |= color(Color::Green) | bold;
+                else if (cell == "T") t |= color(Color::Gold1) | bold;
+                else if (cell == "H") t |= color(Color::Magenta1) | bold;
+                else if (cell == "■") t |= color(Color::Yellow);
+                else if (cell == ">") t |= color(Color::Green);
+                else if (cell == "=") t |= color(Color::Cyan);
+                else if (cell == "#" || cell == "┌" || cell == "┐" || cell == "└" || cell == "┘" || cell == "─" || cell == "│") t |= color(Color::Cyan);
+                else if (cell == ".") t |= color(Color::GrayDark);
+                line_elems.push_back(t);
+            }
+            rows_elements.push_back(hbox(line_elems));
+        }
+
+        auto map_title = text(" SECTOR: " + state.map.mapName + " ") | hcenter | bold;
+        return vbox({
+            map_title | bgcolor(Color::Cyan) | color(Color::Black),
+            vbox(rows_elements) | center | flex
+        });
+    }
+
+    Layers buildLayers() {
+        static const char *glyphs[] = {".", ".", "#", " ", ".", "│", "─", ".", "┌", "┐", ".", " "};
+        Layers layers;
+        for (const char *key: {"-1", "0"}) {
+            auto &rows = layers[key];
+            for (int y = 0; y <= 2 * RangeY; ++y) {
+                std::string row;
+                for (int x = 0; x <= 2 * RangeX; ++x) row += glyphs[(x * 7 + y * 13) % 12];
+                rows.push_back(std::move(row));
+            }
+        }
+        return layers;
+    }
+
+    void populate(GameState &state) {
+        state.map.mapName = "Hlavni nadrazi";
+        state.map.centerX = 500;
+        state.map.centerY = 300;
+        state.map.rangeX = RangeX;
+        state.map.rangeY = RangeY;
+        state.player.x = 500;
+        state.player.y = 300;
+        dto::NpcsUpdateResponse npcs;
+        for (int i = 0; i < 30; ++i) {
+            dto::NpcDto npc;
+            npc.name = "npc";
+            npc.x = 440 + i * 4;
+            npc.y = 285 + i % 30;
+            npc.aggressive = i % 3 == 0;
+            npc.interaction = i % 3 == 1 ? "TRADE" : "TALK";
+            npcs.push_back(npc);
+        }
+        state.updateNpcs(std::move(npcs));
+
+        dto::MapObjectsUpdateResponse objects;
+        for (int i = 0; i < 10; ++i) {
+            dto::MapObjectDto obj;
+            obj.x = 430 + i * 13;
+            obj.y = 290 + i;
+            obj.type = i % 2 ? "CONTAINER" : "EXIT";
+            objects.push_back(obj);
+        }
+        state.updateObjects(std::move(objects));
+
+        dto::OtherPlayersUpdateResponse others;
+        for (int i = 0; i < 5; ++i) {
+            dto::OtherPlayerDto other;
+            other.x = 480 + i * 9;
+            other.y = 295 + i * 2;
+            others.push_back(other);
+        }
+        state.updateOtherPlayers(std::move(others));
+    }
+
+    std::string draw(const Element &element) {
+        auto screen = Screen::Create(Dimension::Fixed(MapMaxWidth), Dimension::Fixed(MapMaxHeightNoLogs + 1));
+        Render(screen, element);
+        return screen.ToString();
+    }
+}
+
+int main() {
+    const Layers layers = buildLayers();
+    GameState state;
+    populate(state);
+    dto::MapDataResponse map = state.map;
+    map.layers = layers;
+    state.updateMap(std::move(map));
+
+    TuiRenderer renderer;
+    if (draw(legacyBuildMap(state, layers)) != draw(renderer.buildMap(state))) {
+        std::printf("buildMap draws a different map than the reference\n");
+        return 1;
+    }
+
+    constexpr std::size_t Iterations = 300;
+    std::size_t sink = 0;
+    const double legacyBuild = bench::timePerCall(Iterations, [&] { sink += legacyBuildMap(state, layers) != nullptr; });
+    const double gridBuild = bench::timePerCall(Iterations, [&] { sink += renderer.buildMap(state) != nullptr; });
+    const double legacyFrame = bench::timePerCall(Iterations, [&] { sink += draw(legacyBuildMap(state, layers)).size(); });
+    const double gridFrame = bench::timePerCall(Iterations, [&] { sink += draw(renderer.buildMap(state)).size(); });
+
+    std::printf("buildMap %dx%d viewport\n", MapMaxWidth, MapMaxHeightNoLogs);
+    std::printf("  build only       split_utf8 %10.0fns   tile grid %10.0fns   %.1fx\n",
+                legacyBuild, gridBuild, legacyBuild / gridBuild);
+    std::printf("  build + Render   split_utf8 %10.0fns   tile grid %10.0fns   %.1fx\n",
+                legacyFrame, gridFrame, legacyFrame / gridFrame);
+    return sink == 0;
+}
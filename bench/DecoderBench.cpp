@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "BenchHarness.h"
+#include "event/EventType.h"
+#include "utils/JsonParser.h"
+#include "utils/SaxDecoder.h"
+
+/**
+ * Compares the DOM decode path (json::parse into the frame arena + JsonParser) with
+ * the streaming SaxDecoder on NPCS_UPDATE frames of growing size.
+ */
+namespace {
+    std::string buildNpcFrame(const int count) {
+        nlohmann::json npcs = nlohmann::json::array();
+        for (int i = 0; i < count; ++i) {
+            npcs.push_back({
+                {"id", "npc-" + std::to_string(i)},
+                {"name", i % 3 ? "Mutated Rat" : "Metro Trader Vasek"},
+                {"type", i % 3 ? "MUTANT" : "HUMAN"},
+                {"x", i % 154}, {"y", i / 154}, {"z", 0},
+                {"hp", 40}, {"maxHp", 40},
+                {"aggressive", i % 3 != 0},
+                {"interaction", i % 3 ? "ATTACK" : "TRADE"}
+            });
+        }
+        return std::string("{\"type\":\"NPCS_UPDATE\",\"payload\":") + npcs.dump() + "}";
+    }
+
+    /** @brief Same frame as nlohmann itself writes it, with the keys sorted. */
+    std::string payloadFirst(const std::string &frame) {
+        return nlohmann::json::parse(frame).dump();
+    }
+
+    std::size_t decodeSax(const std::string &frame) {
+        EventType type;
+        dto::ServerMessage message;
+        if (!utils::SaxDecoder::decode(frame, WireFormat::JSON, type, message)) {
+            std::printf("SaxDecoder fell back on an NPCS_UPDATE frame\n");
+            std::exit(1);
+        }
+        return std::get<dto::NpcsUpdateResponse>(message).size();
+    }
+}
+
+int main() {
+    std::size_t sink = 0;
+    for (const int count: {10, 100, 1000, 10000}) {
+        const std::string frame = buildNpcFrame(count);
+        const std::size_t iterations = count >= 10000 ? 20 : 200000 / count;
+
+        const double dom = bench::timePerCall(iterations, [&] {
+            utils::FrameArena::Scope arenaScope;
+            const auto json = utils::json::parse(frame);
+            const auto message = utils::JsonParser::parseServerMessage(EventType::SEND_NPCS, json);
+            sink += std::get<dto::NpcsUpdateResponse>(message).size();
+        });
+
+        const double sax = bench::timePerCall(iterations, [&] { sink += decodeSax(frame); });
+        const std::string sorted = payloadFirst(frame);
+        const double saxSorted = bench::timePerCall(iterations, [&] { sink += decodeSax(sorted); });
+
+        std::printf("NPCS_UPDATE %5d npcs (%7zu B): DOM %10.0fns  SAX %10.0fns (%.2fx, %.0f MB/s)"
+                    "  SAX payload-first %10.0fns (%.2fx)\n",
+                    count, frame.size(), dom, sax, dom / sax, static_cast<double>(frame.size()) / sax * 1000.0,
+                    saxSorted, dom / saxSorted);
+    }
+    return sink == 0;
+}
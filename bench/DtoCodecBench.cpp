@@ -0,0 +1,125 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "dto/GameRequests.h"
+#include "utils/DtoCodec.h"
+#include "utils/JsonParser.h"
+
+using utils::json;
+
+/**
+ * Decoding a 1,000-item trade catalog (OPEN_TRADE_UI payload) with JsonParser, which
+ * now goes through DtoCodec, against the previous hand-written parseItem kept below:
+ * safeString/safeInt per field, each doing contains, operator[] and value.
+ *
+ * Also times encoding a BUY request both ways. The decoded catalogs and encoded
+ * requests must match, otherwise the executable exits with a non-zero status.
+ */
+namespace {
+    constexpr int CatalogSize = 1000;
+
+    dto::ItemDto legacyParseItem(const json &j) {
+        using utils::JsonParser;
+        if (j.is_null()) return {};
+        dto::ItemDto item;
+        item.id = JsonParser::safeString(j, "id", "");
+        item.name = JsonParser::safeString(j, "name", "Unknown");
+        item.type = JsonParser::safeString(j, "type", "MISC");
+        item.description = JsonParser::safeString(j, "description", "");
+        item.rarity = JsonParser::safeString(j, "rarity", "COMMON");
+        item.quantity = JsonParser::safeInt(j, "quantity", 1);
+        item.price = JsonParser::safeInt(j, "price", 0);
+        return item;
+    }
+
+    dto::TradeUiLoadResponse legacyParseTradeUi(const json &j) {
+        using utils::JsonParser;
+        dto::TradeUiLoadResponse trade;
+        trade.npcId = JsonParser::safeString(j, "npcId", "");
+        trade.npcName = JsonParser::safeString(j, "npcName", "");
+        if (j.contains("items") && j["items"].is_array()) {
+            for (const auto &item: j["items"]) {
+                if (!item.is_null()) {
+                    trade.items.push_back(legacyParseItem(item));
+                }
+            }
+        }
+        return trade;
+    }
+
+    json catalog() {
+        static const char *types[] = {"WEAPON", "MASK", "FOOD", "MEDICINE", "MISC"};
+        static const char *rarities[] = {"COMMON", "UNCOMMON", "RARE", "LEGENDARY"};
+        json payload;
+        payload["npcId"] = "npc-trader-1";
+        payload["npcName"] = "Metro Trader Vasek";
+        payload["items"] = json::array();
+        for (int i = 0; i < CatalogSize; ++i) {
+            json item = {
+                {"id", "item-" + std::to_string(i)}, {"name", "Trade good " + std::to_string(i)},
+                {"type", types[i % 5]}, {"rarity", rarities[i % 4]}, {"price", 10 + i % 300}
+            };
+            // Some items leave fields out so both versions fall back to the defaults.
+            if (i % 3 != 0) item["description"] = "Found somewhere in the tunnels, still works.";
+            if (i % 7 != 0) item["quantity"] = 1 + i % 20;
+            payload["items"].push_back(std::move(item));
+        }
+        return payload;
+    }
+
+    bool sameItems(const std::vector<dto::ItemDto> &a, const std::vector<dto::ItemDto> &b) {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i].id != b[i].id || a[i].name != b[i].name || a[i].type != b[i].type
+                || a[i].description != b[i].description || a[i].rarity != b[i].rarity
+                || a[i].quantity != b[i].quantity || a[i].price != b[i].price) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    const json payload = catalog();
+    if (!sameItems(legacyParseTradeUi(payload).items, utils::JsonParser::parseTradeUi(payload).items)) {
+        std::printf("DtoCodec decodes the catalog differently from the reference\n");
+        return 1;
+    }
+
+    dto::BuyRequest buy;
+    buy.npcId = "npc-trader-1";
+    buy.itemIndex = 42;
+    const auto legacyBuy = [&buy] {
+        nlohmann::json payloadJson;
+        payloadJson["npcId"] = buy.npcId;
+        payloadJson["itemIndex"] = buy.itemIndex;
+        nlohmann::json req;
+        req["type"] = "BUY";
+        req["payload"] = payloadJson;
+        return req;
+    };
+    if (legacyBuy() != utils::DtoCodec::encodeRequest(buy)) {
+        std::printf("DtoCodec encodes BUY differently from the reference\n");
+        return 1;
+    }
+
+    std::size_t sink = 0;
+    const double legacyDecode = bench::timePerCall(200, [&] { sink += legacyParseTradeUi(payload).items.size(); });
+    const double codecDecode = bench::timePerCall(200, [&] {
+        sink += utils::JsonParser::parseTradeUi(payload).items.size();
+    });
+    const double legacyEncode = bench::timePerCall(100000, [&] { sink += legacyBuy().size(); });
+    const double codecEncode = bench::timePerCall(100000, [&] {
+        sink += utils::DtoCodec::encodeRequest(buy).size();
+    });
+
+    std::printf("trade catalog of %d items\n", CatalogSize);
+    std::printf("  decode       safeString %10.0fns   DtoCodec %10.0fns   %.1fx\n",
+                legacyDecode, codecDecode, legacyDecode / codecDecode);
+    std::printf("  encode BUY   by hand    %10.0fns   DtoCodec %10.0fns   %.1fx\n",
+                legacyEncode, codecEncode, legacyEncode / codecEncode);
+    return sink == 0;
+}
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "game/GameState.h"
+
+/**
+ * Culling 10k NPCs and players to a 154x40 viewport: the loops buildMap used to run
+ * over the DTO vectors, testing z and the bounds of every entity, against
+ * SpatialIndex::query on the same state.
+ *
+ * Two crowds: one spread over a 1000x1000 hub, where few entities are near the
+ * viewport, and one packed into 400x200 tiles around it, where most blocks under
+ * the viewport are full and the clipping itself dominates. Both versions must find
+ * the same entities, otherwise the executable exits with a non-zero status.
+ */
+namespace {
+    constexpr int Entities = 10000;
+    constexpr int ViewWidth = 154;
+    constexpr int ViewHeight = 40;
+    constexpr int CenterX = 500;
+    constexpr int CenterY = 300;
+
+    void populate(GameState &state, const int spreadX, const int spreadY) {
+        dto::NpcsUpdateResponse npcs;
+        dto::OtherPlayersUpdateResponse others;
+        for (int i = 0; i < Entities; ++i) {
+            const int x = CenterX - spreadX / 2 + i * 7919 % spreadX;
+            const int y = CenterY - spreadY / 2 + i * 104729 % spreadY;
+            if (i % 4 == 0) {
+                dto::OtherPlayerDto other;
+                other.id = "player-" + std::to_string(i);
+                other.name = "Player " + std::to_string(i);
+                other.x = x;
+                other.y = y;
+                other.z = i % 3 - 1;
+                others.push_back(other);
+            } else {
+                dto::NpcDto npc;
+                npc.id = "npc-" + std::to_string(i);
+                npc.name = "Mutated Rat";
+                npc.type = "MUTANT";
+                npc.interaction = "ATTACK";
+                npc.x = x;
+                npc.y = y;
+                npc.z = i % 3 - 1;
+                npcs.push_back(npc);
+            }
+        }
+        state.updateNpcs(std::move(npcs));
+        state.updateOtherPlayers(std::move(others));
+    }
+
+    /** @brief The entities buildMap drew before the index, as "kind * Entities + index". */
+    void cullLegacy(const GameState &state, const int minX, const int minY, const int maxX, const int maxY,
+                    std::vector<std::uint32_t> &out) {
+        const int layer = state.player.layerIndex;
+        for (std::size_t i = 0; i < state.npcs.size(); ++i) {
+            const auto &npc = state.npcs[i];
+            if (npc.z != layer) continue;
+            if (npc.x >= minX && npc.x <= maxX && npc.y >= minY && npc.y <= maxY) {
+                out.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        for (std::size_t i = 0; i < state.otherPlayers.size(); ++i) {
+            const auto &other = state.otherPlayers[i];
+            if (other.z != layer) continue;
+            if (other.x >= minX && other.x <= maxX && other.y >= minY && other.y <= maxY) {
+                out.push_back(static_cast<std::uint32_t>(Entities + i));
+            }
+        }
+    }
+
+    void cullIndexed(const GameState &state, const int minX, const int minY, const int maxX, const int maxY,
+                     std::vector<std::uint32_t> &out) {
+        const int layer = state.player.layerIndex;
+        state.npcIndex.query(layer, minX, minY, maxX, maxY, out);
+        const std::size_t players = out.size();
+        state.otherPlayerIndex.query(layer, minX, minY, maxX, maxY, out);
+        for (std::size_t i = players; i < out.size(); ++i) out[i] += Entities;
+    }
+
+    bool run(const char *name, const int spreadX, const int spreadY) {
+        GameState state;
+        state.player.x = CenterX;
+        state.player.y = CenterY;
+        populate(state, spreadX, spreadY);
+        const int minX = CenterX - ViewWidth / 2;
+        const int minY = CenterY - ViewHeight / 2;
+        const int maxX = minX + ViewWidth - 1;
+        const int maxY = minY + ViewHeight - 1;
+
+        std::vector<std::uint32_t> legacy;
+        std::vector<std::uint32_t> indexed;
+        cullLegacy(state, minX, minY, maxX, maxY, legacy);
+        cullIndexed(state, minX, minY, maxX, maxY, indexed);
+        std::sort(indexed.begin(), indexed.end());
+        if (legacy != indexed) {
+            std::printf("%s: the index found %zu entities, the loops %zu\n", name, indexed.size(), legacy.size());
+            return false;
+        }
+
+        constexpr std::size_t Iterations = 2000;
+        std::size_t sink = 0;
+        const double legacyNs = bench::timePerCall(Iterations, [&] {
+            legacy.clear();
+            cullLegacy(state, minX, minY, maxX, maxY, legacy);
+            sink += legacy.size();
+        });
+        const double indexedNs = bench::timePerCall(Iterations, [&] {
+            indexed.clear();
+            cullIndexed(state, minX, minY, maxX, maxY, indexed);
+            sink += indexed.size();
+        });
+        std::printf("%-22s %5zu visible   DTO loops %9.0fns   index %9.0fns   %.1fx\n",
+                    name, legacy.size(), legacyNs, indexedNs, legacyNs / indexedNs);
+        return sink != 0;
+    }
+}
+
+int main() {
+    std::printf("%d entities, %dx%d viewport\n", Entities, ViewWidth, ViewHeight);
+    const bool sparse = run("1000x1000 hub", 1000, 1000);
+    const bool dense = run("400x200 around view", 400, 200);
+    return sparse && dense ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "AllocationCounter.h"
+#include "event/GameEvent.h"
+#include "event/SpscQueue.h"
+#include "game/GameController.h"
+#include "ui/RenderThread.h"
+#include "utils/JsonParser.h"
+
+/**
+ * Allocation counter check for the inbound event path.
+ *
+ * Counts global operator new calls while a large SEND_MAP_DATA frame travels
+ * parseEvent -> SpscQueue -> GameController::drainEvents, which hands the decoded
+ * message to its handler, applies it to the state and publishes the render
+ * snapshot. That is compared with a bare parse plus DTO decode of the same frame in
+ * a FrameArena::Scope, as parseEvent does it, applied to a GameState directly. Any
+ * deep copy of the DOM or the DTOs along the way, the handler path included, shows
+ * up as a second set of map rows, in which case the executable exits with a
+ * non-zero status.
+ *
+ * The same parse outside a scope, with its DOM taken from the heap node by node, is
+ * reported as well; the difference is what the arena saves per message.
+ */
+namespace {
+    std::string buildMapFrame(const int rows, const int columns) {
+        nlohmann::json layer = nlohmann::json::array();
+        for (int y = 0; y < rows; ++y) {
+            layer.push_back(std::string(columns, y % 2 ? '.' : '#'));
+        }
+        nlohmann::json payload;
+        payload["mapName"] = "Hlavni nadrazi";
+        payload["centerX"] = columns / 2;
+        payload["centerY"] = rows / 2;
+        payload["rangeX"] = columns / 2;
+        payload["rangeY"] = rows / 2;
+        payload["layers"]["0"] = layer;
+        payload["layers"]["-1"] = layer;
+        nlohmann::json root;
+        root["type"] = "MAP_DATA";
+        root["payload"] = payload;
+        return root.dump();
+    }
+}
+
+int main() {
+    // Constant per-message overhead: the aborted streaming attempt, which reads the
+    // envelope up to the type name, the log lines and game log entry the controller
+    // writes, and the snapshot it publishes. A copy of the map rows costs ~180.
+    constexpr std::size_t Slack = 32;
+    const std::string frame = buildMapFrame(80, 154);
+    auto inputQueue = std::make_unique<SpscQueue<GameEvent> >();
+    auto outputQueue = std::make_unique<SpscQueue<GameEvent> >();
+    RenderThread renderThread(ScheduleConfig{});
+    GameController controller(inputQueue.get(), outputQueue.get(), &renderThread);
+    GameState reference;
+
+    const std::size_t heapDom = bench::countAllocations([&] {
+        const auto dom = utils::json::parse(frame);
+        const auto decoded = utils::JsonParser::parseServerMessage(EventType::SEND_MAP_DATA, dom);
+        (void) decoded;
+    });
+
+    const auto directly = [&] {
+        dto::ServerMessage decoded;
+        {
+            utils::FrameArena::Scope arenaScope;
+            const auto dom = utils::json::parse(frame);
+            decoded = utils::JsonParser::parseServerMessage(EventType::SEND_MAP_DATA, dom);
+        }
+        reference.updateMap(std::get<dto::MapDataResponse>(std::move(decoded)));
+    };
+    // The first update sizes the arena and the decoded layers; count one that finds them ready.
+    directly();
+    const std::size_t direct = bench::countAllocations(directly);
+
+    const auto throughPipeline = [&] {
+        const std::uint64_t version = controller.getState().getVersion();
+        inputQueue->enqueue(parseEvent(frame));
+        controller.drainEvents();
+        // updateMap always bumps the version; an unchanged one means the handler never ran.
+        if (controller.getState().getVersion() == version || controller.getState().tileLayers.size() != 2) {
+            std::abort();
+        }
+    };
+    // The first message sizes the arena of this thread; count one that finds it ready.
+    const std::size_t firstMessage = bench::countAllocations(throughPipeline);
+    const std::size_t pipeline = bench::countAllocations(throughPipeline);
+
+    std::printf("frame bytes:                      %zu\n", frame.size());
+    std::printf("allocations, heap DOM + decode:   %zu\n", heapDom);
+    std::printf("allocations, arena decode + apply: %zu\n", direct);
+    std::printf("allocations, first message:       %zu\n", firstMessage);
+    std::printf("allocations, event pipeline:      %zu\n", pipeline);
+    std::printf("decodes per message:              %.2f\n", static_cast<double>(pipeline) / static_cast<double>(direct));
+
+    if (pipeline > direct + Slack) {
+        std::printf("FAIL: the payload DOM or DTO is copied on its way through drainEvents\n");
+        return 1;
+    }
+    std::printf("OK: one decode per inbound message\n");
+    return 0;
+}
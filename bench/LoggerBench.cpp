@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "utils/Logger.h"
+
+/**
+ * Per-call latency of the old logging path, a std::ofstream flushed with std::endl
+ * on every line, against Logger::log, from one thread and from several threads
+ * logging at once. The ofstream is shared behind a mutex in the multi-threaded run,
+ * as it would have to be in the client. Both write to files in the working
+ * directory, which are removed afterwards.
+ *
+ * The threads log back to back, far faster than the client ever does, so the
+ * ring overflows and Logger drops records; the drop count is printed per run.
+ */
+namespace {
+    constexpr std::size_t CallsPerThread = 20000;
+    constexpr const char *OfstreamPath = "logger_bench_ofstream.log";
+    constexpr const char *LoggerPath = "logger_bench_async.log";
+
+    const std::string Message = "Type: SEND_PLAYER_POSITION | Enum: 12";
+
+    template<typename Fn>
+    bench::Stats measure(const int threads, Fn &&logOnce) {
+        std::vector<std::vector<double>> perThread(threads);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::vector<double> &samples = perThread[t];
+                samples.reserve(CallsPerThread);
+                for (std::size_t i = 0; i < CallsPerThread; ++i) {
+                    const auto start = bench::Clock::now();
+                    logOnce();
+                    samples.push_back(bench::nanosBetween(start, bench::Clock::now()));
+                }
+            });
+        }
+        for (auto &worker: workers) worker.join();
+
+        std::vector<double> samples;
+        for (const auto &threadSamples: perThread) {
+            samples.insert(samples.end(), threadSamples.begin(), threadSamples.end());
+        }
+        return bench::summarize(samples);
+    }
+}
+
+int main() {
+    for (const int threads: {1, 4}) {
+        const std::string suffix = " x" + std::to_string(threads) + " threads";
+
+        {
+            std::ofstream logger(OfstreamPath, std::ios::app);
+            std::mutex loggerMutex;
+            auto stats = measure(threads, [&] {
+                std::lock_guard lock(loggerMutex);
+                logger << "[EVENT] " << Message << std::endl;
+            });
+            bench::printStats("ofstream + std::endl" + suffix, stats);
+        }
+
+        const uint64_t droppedBefore = Logger::droppedRecords();
+        Logger::start({LoggerPath, LogLevel::DEBUG, LogFormat::TEXT});
+        auto stats = measure(threads, [] { Logger::log(LogLevel::DEBUG, "EVENT", Message); });
+        Logger::stop();
+        bench::printStats("Logger::log" + suffix, stats);
+        std::printf("%-40s %llu of %zu records dropped\n", "",
+                    static_cast<unsigned long long>(Logger::droppedRecords() - droppedBefore), stats.count);
+    }
+
+    std::remove(OfstreamPath);
+    std::remove(LoggerPath);
+    return 0;
+}
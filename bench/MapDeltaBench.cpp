@@ -0,0 +1,157 @@
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "event/GameEvent.h"
+#include "game/GameState.h"
+
+/**
+ * Compares a full SEND_MAP_DATA resend with a MAP_DELTA for single steps on a
+ * large viewport: bytes per frame and parse + apply time on the client.
+ *
+ * Each delta is also checked against the full map at the new center, so the
+ * executable exits with a non-zero status if applyMapDelta drifts. Steps go in
+ * every direction, so the left and upward shifts that start at the edges of the
+ * tile grid run too; build with checked iterators to catch any stray offset.
+ */
+namespace {
+    constexpr int RangeX = 77;
+    constexpr int RangeY = 40;
+    const char *Layers[] = {"-1", "0", "1"};
+
+    std::string glyphAt(const int x, const int y, const int z) {
+        static const char *glyphs[] = {".", ".", "#", ",", ".", "│", "─", ".", ":", "~", ".", "┌"};
+        return glyphs[static_cast<unsigned>(x * 7 + y * 13 + z * 5) % 12];
+    }
+
+    std::string row(const int left, const int y, const int z) {
+        std::string tiles;
+        for (int x = left; x <= left + 2 * RangeX; ++x) tiles += glyphAt(x, y, z);
+        return tiles;
+    }
+
+    std::string column(const int x, const int top, const int z) {
+        std::string tiles;
+        for (int y = top; y <= top + 2 * RangeY; ++y) tiles += glyphAt(x, y, z);
+        return tiles;
+    }
+
+    std::string fullFrame(const int centerX, const int centerY) {
+        nlohmann::json payload;
+        payload["mapName"] = "Hlavni nadrazi";
+        payload["centerX"] = centerX;
+        payload["centerY"] = centerY;
+        payload["rangeX"] = RangeX;
+        payload["rangeY"] = RangeY;
+        for (const char *layer: Layers) {
+            nlohmann::json rows = nlohmann::json::array();
+            for (int y = centerY - RangeY; y <= centerY + RangeY; ++y) {
+                rows.push_back(row(centerX - RangeX, y, std::stoi(layer)));
+            }
+            payload["layers"][layer] = std::move(rows);
+        }
+        return nlohmann::json{{"type", "MAP_DATA"}, {"payload", payload}}.dump();
+    }
+
+    std::string deltaFrame(const int baseX, const int baseY, const int dx, const int dy) {
+        const int centerX = baseX + dx;
+        const int centerY = baseY + dy;
+        nlohmann::json payload;
+        payload["baseX"] = baseX;
+        payload["baseY"] = baseY;
+        payload["centerX"] = centerX;
+        payload["centerY"] = centerY;
+        for (const char *layer: Layers) {
+            const int z = std::stoi(layer);
+            for (int i = 0; i < std::abs(dy); ++i) {
+                const int y = dy > 0 ? centerY + RangeY - i : centerY - RangeY + i;
+                payload["rows"][layer].push_back({{"y", y}, {"tiles", row(centerX - RangeX, y, z)}});
+            }
+            for (int i = 0; i < std::abs(dx); ++i) {
+                const int x = dx > 0 ? centerX + RangeX - i : centerX - RangeX + i;
+                payload["columns"][layer].push_back({{"x", x}, {"tiles", column(x, centerY - RangeY, z)}});
+            }
+        }
+        payload["tiles"].push_back({{"x", centerX}, {"y", centerY - 1}, {"z", 0}, {"glyph", glyphAt(centerX, centerY - 1, 0)}});
+        return nlohmann::json{{"type", "MAP_DELTA"}, {"payload", payload}}.dump();
+    }
+
+    /** @brief The decoded layers as text again, comparable across GameStates. */
+    std::map<std::string, std::vector<std::string> > layerText(const GameState &state) {
+        std::map<std::string, std::vector<std::string> > layers;
+        for (const auto &[key, layer]: state.tileLayers) {
+            auto &rows = layers[key];
+            for (int y = 0; y < layer.height; ++y) {
+                std::string row;
+                for (int x = 0; x < layer.width; ++x) row += state.glyphs.glyph(layer.at(x, y));
+                rows.push_back(std::move(row));
+            }
+        }
+        return layers;
+    }
+
+    void apply(GameState &state, GameEvent event) {
+        if (auto *map = std::get_if<dto::MapDataResponse>(&event.getMessage())) {
+            state.updateMap(std::move(*map));
+        } else if (!state.applyMapDelta(std::get<dto::MapDeltaResponse>(event.getMessage()))) {
+            std::printf("delta rejected\n");
+            std::exit(1);
+        }
+    }
+}
+
+int main() {
+    constexpr int StartX = 500;
+    constexpr int StartY = 300;
+    const std::string start = fullFrame(StartX, StartY);
+    std::size_t sink = 0;
+
+    const struct {
+        const char *name;
+        int dx;
+        int dy;
+    } steps[] = {
+        {"step right", 1, 0}, {"step left", -1, 0}, {"step up", 0, -1}, {"step diagonal", -1, 1},
+        {"step up-left", -1, -1}, {"dash left", -3, 0}, {"dash down", 2, 4}
+    };
+
+    for (const auto &[name, dx, dy]: steps) {
+        const std::string full = fullFrame(StartX + dx, StartY + dy);
+        const std::string delta = deltaFrame(StartX, StartY, dx, dy);
+
+        GameState expected;
+        apply(expected, parseEvent(full));
+        GameState actual;
+        apply(actual, parseEvent(start));
+        apply(actual, parseEvent(delta));
+        apply(expected, parseEvent(deltaFrame(StartX + dx, StartY + dy, 0, 0)));
+        if (expected.tileLayers.empty() || layerText(actual) != layerText(expected) || actual.map.centerX != expected.map.centerX
+            || actual.map.centerY != expected.map.centerY) {
+            std::printf("%s: delta result differs from the full map\n", name);
+            return 1;
+        }
+
+        GameState state;
+        const double fullNs = bench::timePerCall(200, [&] {
+            apply(state, parseEvent(full));
+            sink += state.tileLayers.size();
+        });
+
+        // Walk back and forth so every delta applies on top of the previous one.
+        const std::string back = deltaFrame(StartX + dx, StartY + dy, -dx, -dy);
+        apply(state, parseEvent(start));
+        const double deltaNs = bench::timePerCall(1000, [&] {
+            apply(state, parseEvent(delta));
+            apply(state, parseEvent(back));
+            sink += state.tileLayers.size();
+        }) / 2;
+
+        std::printf("%-14s MAP_DATA %7zu B %10.0fns   MAP_DELTA %6zu B %10.0fns   %5.1fx fewer bytes, %5.1fx faster\n",
+                    name, full.size(), fullNs, delta.size(), deltaNs,
+                    static_cast<double>(full.size()) / static_cast<double>(delta.size()), fullNs / deltaNs);
+    }
+    return sink == 0;
+}
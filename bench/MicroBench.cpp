@@ -0,0 +1,306 @@
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ftxui/dom/elements.hpp>
+#include <ftxui/screen/screen.hpp>
+
+#include "BenchHarness.h"
+#include "event/BlockingQueue.h"
+#include "event/EventType.h"
+#include "event/GameEvent.h"
+#include "event/MpscQueue.h"
+#include "game/GameState.h"
+#include "game/TileGrid.h"
+#include "ui/TuiRenderer.h"
+#include "utils/JsonParser.h"
+#include "utils/Utf8.h"
+
+/**
+ * Microbenchmarks of the decode, queue and map drawing building blocks, meant to
+ * be compared between two builds:
+ *
+ *     micro_bench --out before.json
+ *     (rebuild)
+ *     micro_bench --out after.json --compare before.json
+ *
+ * --filter TEXT runs only the cases whose name contains TEXT. Every case reports
+ * nanoseconds per operation; the JSON file holds the same numbers.
+ *
+ * Map rows are no longer split with split_utf8; the UTF-8 cases time decodeLayer,
+ * which took its place, and Utf8::glyphCount.
+ */
+namespace {
+    /** @brief Map sizes as (rangeX, rangeY); the map is (2 * range + 1) tiles across. */
+    const std::pair<int, int> MapRanges[] = {{20, 10}, {40, 20}, {77, 40}};
+
+    std::string sizeName(const int rangeX, const int rangeY) {
+        return std::to_string(2 * rangeX + 1) + "x" + std::to_string(2 * rangeY + 1);
+    }
+
+    std::vector<std::string> mapRows(const int rangeX, const int rangeY) {
+        static const char *glyphs[] = {".", ".", "#", ",", ".", "│", "─", ".", ":", "~", ".", "┌"};
+        std::vector<std::string> rows;
+        for (int y = 0; y <= 2 * rangeY; ++y) {
+            std::string row;
+            for (int x = 0; x <= 2 * rangeX; ++x) row += glyphs[(x * 7 + y * 13) % 12];
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    }
+
+    nlohmann::json mapPayload(const int rangeX, const int rangeY) {
+        nlohmann::json payload;
+        payload["mapName"] = "Hlavni nadrazi";
+        payload["centerX"] = 500;
+        payload["centerY"] = 300;
+        payload["centerZ"] = 0;
+        payload["rangeX"] = rangeX;
+        payload["rangeY"] = rangeY;
+        for (const char *layer: {"-1", "0", "1"}) {
+            payload["layers"][layer] = mapRows(rangeX, rangeY);
+        }
+        return payload;
+    }
+
+    nlohmann::json npcPayload(const int count) {
+        nlohmann::json npcs = nlohmann::json::array();
+        for (int i = 0; i < count; ++i) {
+            npcs.push_back({
+                {"id", "npc-" + std::to_string(i)}, {"name", i % 3 ? "Mutated Rat" : "Metro Trader Vasek"},
+                {"type", i % 3 ? "MUTANT" : "HUMAN"}, {"x", 440 + i % 150}, {"y", 280 + i % 40}, {"z", 0},
+                {"hp", 40}, {"maxHp", 40}, {"aggressive", i % 3 != 0}, {"interaction", i % 3 ? "ATTACK" : "TRADE"}
+            });
+        }
+        return npcs;
+    }
+
+    std::string frameOf(const char *type, const nlohmann::json &payload) {
+        return nlohmann::json{{"type", type}, {"payload", payload}}.dump();
+    }
+
+    void jsonCases(bench::Suite &suite, std::size_t &sink) {
+        for (const auto &[rangeX, rangeY]: MapRanges) {
+            const utils::json payload = mapPayload(rangeX, rangeY);
+            suite.run("JsonParser::parseMap " + sizeName(rangeX, rangeY), 500, [&] {
+                sink += utils::JsonParser::parseMap(payload).layers.size();
+            });
+        }
+        for (const int count: {10, 100, 1000}) {
+            const utils::json payload = npcPayload(count);
+            suite.run("JsonParser::parseNpcs " + std::to_string(count), 200000 / count, [&] {
+                sink += utils::JsonParser::parseNpcs(payload).size();
+            });
+        }
+        const utils::json item = {
+            {"id", "item-7"}, {"name", "Gas Mask"}, {"type", "MASK"}, {"description", "Filters most of the dust."},
+            {"rarity", "RARE"}, {"quantity", 1}, {"price", 120}
+        };
+        suite.run("JsonParser::parseItem", 200000, [&] { sink += utils::JsonParser::parseItem(item).price; });
+    }
+
+    void parseEventCases(bench::Suite &suite, std::size_t &sink) {
+        const std::string position = frameOf("SEND_PLAYER_POSITION", {{"x", 500}, {"y", 300}, {"z", 0}});
+        suite.run("parseEvent SEND_PLAYER_POSITION", 100000, [&] {
+            sink += static_cast<std::size_t>(parseEvent(position).getType());
+        });
+        const std::string npcs = frameOf("NPCS_UPDATE", npcPayload(100));
+        suite.run("parseEvent NPCS_UPDATE 100", 5000, [&] {
+            sink += static_cast<std::size_t>(parseEvent(npcs).getType());
+        });
+        for (const auto &[rangeX, rangeY]: MapRanges) {
+            const std::string map = frameOf("MAP_DATA", mapPayload(rangeX, rangeY));
+            suite.run("parseEvent MAP_DATA " + sizeName(rangeX, rangeY), 300, [&] {
+                sink += static_cast<std::size_t>(parseEvent(map).getType());
+            });
+        }
+    }
+
+    void typeLookupCases(bench::Suite &suite, std::size_t &sink) {
+        const std::string known = "SEND_PLAYER_POSITION";
+        const std::string unknown = "SEND_SOMETHING_NEW";
+        suite.run("eventTypeFromName hit", 1000000, [&] {
+            sink += static_cast<std::size_t>(eventTypeFromName(known));
+        });
+        suite.run("eventTypeFromName miss", 1000000, [&] {
+            sink += static_cast<std::size_t>(eventTypeFromName(unknown));
+        });
+    }
+
+    /**
+     * @brief Pushes items from several threads while one thread pops them, and records ns per item.
+     */
+    template<typename Queue, typename Push>
+    void contentionCase(bench::Suite &suite, const std::string &name, const int producers, Push &&push) {
+        if (!suite.selected(name)) return;
+        constexpr std::size_t ItemsPerProducer = 100000;
+        constexpr int Rounds = 5;
+        std::vector<double> samples;
+        for (int round = 0; round < Rounds; ++round) {
+            Queue queue;
+            std::atomic<bool> go{false};
+            std::vector<std::thread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&] {
+                    while (!go) {}
+                    for (std::size_t i = 0; i < ItemsPerProducer; ++i) push(queue, static_cast<int>(i));
+                });
+            }
+            const std::size_t total = ItemsPerProducer * producers;
+            const auto start = bench::Clock::now();
+            go = true;
+            int item = 0;
+            for (std::size_t popped = 0; popped < total;) {
+                if (queue.tryPop(item)) ++popped;
+            }
+            samples.push_back(bench::nanosBetween(start, bench::Clock::now()) / static_cast<double>(total));
+            for (auto &thread: threads) thread.join();
+        }
+        suite.record(name, ItemsPerProducer * producers * Rounds, bench::summarize(samples));
+    }
+
+    void queueCases(bench::Suite &suite) {
+        using Mpsc = MpscQueue<int, 4096>;
+        const auto blockingPush = [](BlockingQueue<int> &queue, const int item) { queue.enqueue(item); };
+        const auto mpscPush = [](Mpsc &queue, int item) {
+            while (!queue.tryEnqueue(std::move(item))) std::this_thread::yield();
+        };
+        for (const int producers: {1, 4}) {
+            const std::string suffix = " " + std::to_string(producers) + "p1c";
+            contentionCase<BlockingQueue<int> >(suite, "BlockingQueue enqueue/tryPop" + suffix, producers, blockingPush);
+            contentionCase<Mpsc>(suite, "MpscQueue tryEnqueue/tryPop" + suffix, producers, mpscPush);
+        }
+    }
+
+    void utf8Cases(bench::Suite &suite, std::size_t &sink) {
+        for (const auto &[rangeX, rangeY]: MapRanges) {
+            const std::vector<std::string> rows = mapRows(rangeX, rangeY);
+            suite.run("decodeLayer " + sizeName(rangeX, rangeY), 2000, [&] {
+                GlyphTable glyphs;
+                sink += decodeLayer(glyphs, rows).tiles.size();
+            });
+            suite.run("Utf8::glyphCount row of " + std::to_string(2 * rangeX + 1), 200000, [&] {
+                sink += utils::Utf8::glyphCount(rows[0]);
+            });
+        }
+    }
+
+    /**
+     * @brief NPCs and other players scattered over a hub of `spread` tiles square on three layers.
+     */
+    void populateCrowd(GameState &state, const int count, const int spread) {
+        dto::NpcsUpdateResponse npcs;
+        dto::OtherPlayersUpdateResponse others;
+        for (int i = 0; i < count; ++i) {
+            const int x = 500 - spread / 2 + i * 7919 % spread;
+            const int y = 300 - spread / 2 + i * 104729 % spread;
+            if (i % 4 == 0) {
+                dto::OtherPlayerDto other;
+                other.x = x;
+                other.y = y;
+                other.z = i % 3 - 1;
+                others.push_back(other);
+            } else {
+                dto::NpcDto npc;
+                npc.name = "npc " + std::to_string(i);
+                npc.x = x;
+                npc.y = y;
+                npc.z = i % 3 - 1;
+                npcs.push_back(npc);
+            }
+        }
+        state.updateNpcs(std::move(npcs));
+        state.updateOtherPlayers(std::move(others));
+    }
+
+    void buildMapCases(bench::Suite &suite, std::size_t &sink) {
+        TuiRenderer renderer;
+        for (const auto &[rangeX, rangeY]: MapRanges) {
+            GameState state;
+            state.updateMap(utils::JsonParser::parseMap(mapPayload(rangeX, rangeY)));
+            state.player.x = 500;
+            state.player.y = 300;
+            populateCrowd(state, 20, 2 * rangeY);
+            auto screen = ftxui::Screen::Create(ftxui::Dimension::Fixed(2 * rangeX + 3),
+                                                ftxui::Dimension::Fixed(2 * rangeY + 3));
+            const std::string size = sizeName(rangeX, rangeY);
+            suite.run("TuiRenderer::buildMap " + size, 500, [&] { sink += renderer.buildMap(state) != nullptr; });
+            suite.run("TuiRenderer::buildMap + Render " + size, 500, [&] {
+                ftxui::Render(screen, renderer.buildMap(state));
+                sink += screen.dimx();
+            });
+        }
+        // A hub crowded far beyond the viewport; only the visible blocks should cost anything.
+        for (const int count: {1000, 10000}) {
+            GameState state;
+            state.updateMap(utils::JsonParser::parseMap(mapPayload(77, 40)));
+            state.player.x = 500;
+            state.player.y = 300;
+            populateCrowd(state, count, 1000);
+            suite.run("TuiRenderer::buildMap 155x81 hub of " + std::to_string(count), 500, [&] {
+                sink += renderer.buildMap(state) != nullptr;
+            });
+        }
+    }
+
+    /**
+     * @brief Prints the change of every case against a file written by an earlier run.
+     */
+    bool compareWith(const std::string &path, const bench::Suite &suite) {
+        std::ifstream file(path);
+        if (!file) {
+            std::printf("cannot read %s\n", path.c_str());
+            return false;
+        }
+        const nlohmann::json baseline = nlohmann::json::parse(file, nullptr, false);
+        if (baseline.is_discarded() || !baseline.contains("results")) {
+            std::printf("%s is not a micro_bench result file\n", path.c_str());
+            return false;
+        }
+        std::printf("\n%-44s %14s %14s %8s\n", "compared with baseline", "baseline", "now", "change");
+        for (const bench::Result &result: suite.getResults()) {
+            for (const auto &old: baseline["results"]) {
+                if (old.value("name", "") != result.name) continue;
+                const double before = old.value("mean_ns", 0.0);
+                const double now = result.perOperation.mean;
+                std::printf("%-44s %12.1fns %12.1fns %+7.1f%%\n", result.name.c_str(), before, now,
+                            before > 0 ? (now - before) / before * 100.0 : 0.0);
+            }
+        }
+        return true;
+    }
+}
+
+int main(const int argc, char *argv[]) {
+    std::string outPath = "micro_bench.json";
+    std::string comparePath;
+    std::string filter;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string option = argv[i];
+        if (option == "--out") outPath = argv[i + 1];
+        else if (option == "--compare") comparePath = argv[i + 1];
+        else if (option == "--filter") filter = argv[i + 1];
+    }
+
+    bench::Suite suite(filter);
+    std::size_t sink = 0;
+    jsonCases(suite, sink);
+    parseEventCases(suite, sink);
+    typeLookupCases(suite, sink);
+    queueCases(suite);
+    utf8Cases(suite, sink);
+    buildMapCases(suite, sink);
+
+    if (!suite.writeJson(outPath)) {
+        std::printf("cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+    std::printf("results written to %s (checksum %zu)\n", outPath.c_str(), sink);
+    if (!comparePath.empty() && !compareWith(comparePath, suite)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <ftxui/dom/elements.hpp>
+#include <ftxui/screen/screen.hpp>
+
+#include "AllocationCounter.h"
+#include "BenchHarness.h"
+#include "event/GameEvent.h"
+#include "event/SpscQueue.h"
+#include "game/GameController.h"
+#include "network/FrameCapture.h"
+#include "ui/RenderThread.h"
+#include "ui/TuiRenderer.h"
+#include "utils/DtoPool.h"
+#include "utils/FrameArena.h"
+
+/**
+ * Throughput of the whole inbound pipeline without a terminal or a socket: every
+ * frame is decoded by parseEvent, applied by GameController::drainEvents (which
+ * also publishes the render snapshot) and drawn by TuiRenderer::buildFrame into an
+ * offscreen Screen, one frame per event.
+ *
+ * Plays the received frames of a --record capture given as the only argument, or
+ * a synthetic session: a three-layer 155x81 map followed by movement, stats, NPC
+ * updates and chat. Reports events per second, the p50/p99 of the per-event time
+ * and of the frame build alone, heap allocations per event, and how much of the
+ * decoding the frame arena and the DTO pools absorbed.
+ */
+namespace {
+    constexpr int RangeX = 77;
+    constexpr int RangeY = 40;
+    constexpr int SyntheticEvents = 3000;
+    constexpr int ScreenWidth = 160;
+    constexpr int ScreenHeight = 50;
+
+    std::string frameOf(const char *type, const nlohmann::json &payload) {
+        return nlohmann::json{{"type", type}, {"payload", payload}}.dump();
+    }
+
+    std::vector<CapturedFrame> syntheticSession() {
+        static const char *glyphs[] = {".", ".", "#", ",", ".", "│", "─", ".", ":", "~", ".", "┌"};
+        std::vector<CapturedFrame> frames;
+        const auto add = [&frames](std::string bytes) {
+            CapturedFrame frame;
+            frame.bytes = std::move(bytes);
+            frames.push_back(std::move(frame));
+        };
+
+        nlohmann::json map;
+        map["mapName"] = "Hlavni nadrazi";
+        map["centerX"] = 500;
+        map["centerY"] = 300;
+        map["centerZ"] = 0;
+        map["rangeX"] = RangeX;
+        map["rangeY"] = RangeY;
+        for (const char *layer: {"-1", "0", "1"}) {
+            nlohmann::json rows = nlohmann::json::array();
+            for (int y = 0; y <= 2 * RangeY; ++y) {
+                std::string row;
+                for (int x = 0; x <= 2 * RangeX; ++x) row += glyphs[(x * 7 + y * 13) % 12];
+                rows.push_back(std::move(row));
+            }
+            map["layers"][layer] = std::move(rows);
+        }
+        add(frameOf("MAP_DATA", map));
+
+        for (int i = 0; i < SyntheticEvents; ++i) {
+            switch (i % 10) {
+                case 0: {
+                    nlohmann::json npcs = nlohmann::json::array();
+                    for (int n = 0; n < 40; ++n) {
+                        npcs.push_back({
+                            {"id", "npc-" + std::to_string(n)}, {"name", n % 3 ? "Mutated Rat" : "Metro Trader Vasek"},
+                            {"type", n % 3 ? "MUTANT" : "HUMAN"}, {"x", 440 + n * 3 + i % 3}, {"y", 280 + n % 40},
+                            {"z", 0}, {"hp", 40}, {"maxHp", 40}, {"aggressive", n % 3 != 0},
+                            {"interaction", n % 3 ? "ATTACK" : "TRADE"}
+                        });
+                    }
+                    add(frameOf("NPCS_UPDATE", npcs));
+                    break;
+                }
+                case 5:
+                    add(frameOf("STATS_UPDATE", {{"hp", 100 - i % 50}, {"maxHp", 100}, {"credits", i}}));
+                    break;
+                case 9:
+                    add(frameOf("BROADCAST_CHAT_MSG", {{"message", "Player " + std::to_string(i) + ": anyone near the exit?"}}));
+                    break;
+                default:
+                    add(frameOf("SEND_PLAYER_POSITION", {{"x", 500 + i % 20}, {"y", 300}, {"z", 0}}));
+                    break;
+            }
+        }
+        return frames;
+    }
+
+    std::vector<CapturedFrame> recordedSession(const char *path) {
+        CaptureReader reader(path);
+        if (!reader.isOpen()) {
+            std::printf("%s is not a capture file\n", path);
+            std::exit(1);
+        }
+        std::vector<CapturedFrame> frames;
+        for (CapturedFrame frame; reader.next(frame);) {
+            if (frame.direction == FrameDirection::IN) {
+                frames.push_back(frame);
+            }
+        }
+        return frames;
+    }
+}
+
+int main(const int argc, char *argv[]) {
+    const std::vector<CapturedFrame> frames = argc > 1 ? recordedSession(argv[1]) : syntheticSession();
+    std::size_t bytes = 0;
+    for (const auto &frame: frames) bytes += frame.bytes.size();
+    std::printf("%s: %zu frames, %zu bytes\n", argc > 1 ? argv[1] : "synthetic session", frames.size(), bytes);
+
+    SpscQueue<GameEvent> inputQueue;
+    SpscQueue<GameEvent> outputQueue;
+    RenderThread renderThread(ScheduleConfig{});
+    GameController controller(&inputQueue, &outputQueue, &renderThread);
+    TuiRenderer renderer;
+    auto screen = ftxui::Screen::Create(ftxui::Dimension::Fixed(ScreenWidth), ftxui::Dimension::Fixed(ScreenHeight));
+
+    std::vector<double> eventNanos;
+    std::vector<double> frameNanos;
+    eventNanos.reserve(frames.size());
+    frameNanos.reserve(frames.size());
+    std::size_t failed = 0;
+    GameEvent outbound(EventType::UNKNOWN, nullptr);
+
+    const std::size_t allocationsBefore = bench::allocations.load();
+    const auto start = bench::Clock::now();
+    for (const auto &frame: frames) {
+        const auto eventStart = bench::Clock::now();
+        try {
+            inputQueue.enqueue(parseEvent(frame.bytes, frame.format));
+        } catch (const std::exception &) {
+            ++failed;
+            continue;
+        }
+        controller.drainEvents();
+        // Whatever the controller answers would go to the server; drop it.
+        while (outputQueue.tryPop(outbound)) {}
+
+        const auto frameStart = bench::Clock::now();
+        ftxui::Render(screen, renderer.buildFrame(controller.getState()));
+        const auto frameEnd = bench::Clock::now();
+        eventNanos.push_back(bench::nanosBetween(eventStart, frameEnd));
+        frameNanos.push_back(bench::nanosBetween(frameStart, frameEnd));
+    }
+    const double seconds = bench::nanosBetween(start, bench::Clock::now()) / 1e9;
+    const std::size_t allocated = bench::allocations.load() - allocationsBefore;
+
+    const std::size_t events = eventNanos.size();
+    std::printf("events/s                                 %10.0f\n", static_cast<double>(events) / seconds);
+    bench::printStats("per event (decode, apply, draw)", bench::summarize(eventNanos));
+    bench::printStats("per frame (buildFrame + Render)", bench::summarize(frameNanos));
+    std::printf("allocations per event                    %10.1f\n",
+                events ? static_cast<double>(allocated) / static_cast<double>(events) : 0.0);
+
+    const utils::FrameArenaStats arena = utils::FrameArena::getStats();
+    const utils::DtoPoolStats npcPool = utils::DtoPool<dto::NpcsUpdateResponse>::getStats();
+    std::printf("DOM frames decoded in the arena          %10llu\n", static_cast<unsigned long long>(arena.frames));
+    std::printf("arena allocations per DOM frame          %10.1f\n",
+                arena.frames ? static_cast<double>(arena.allocations) / static_cast<double>(arena.frames) : 0.0);
+    std::printf("arena blocks taken from the heap         %10llu\n",
+                static_cast<unsigned long long>(arena.blockAllocations));
+    std::printf("largest DOM frame                        %10llu B\n",
+                static_cast<unsigned long long>(arena.peakFrameBytes));
+    std::printf("NPC lists refilled from the pool         %10llu of %llu\n",
+                static_cast<unsigned long long>(npcPool.reused), static_cast<unsigned long long>(npcPool.taken));
+    if (failed) {
+        std::printf("%zu frames failed to decode\n", failed);
+        return 1;
+    }
+    return 0;
+}
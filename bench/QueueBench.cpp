@@ -0,0 +1,78 @@
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "event/BlockingQueue.h"
+#include "event/GameEvent.h"
+#include "event/SpscQueue.h"
+
+/**
+ * Compares BlockingQueue and SpscQueue on the network -> main loop path.
+ *
+ * A producer thread plays the IX callback thread and pushes GameEvents at a fixed
+ * rate, a consumer thread plays GameController::drainEvents and drains with tryPop.
+ * Reported are the producer-side enqueue cost and the enqueue-to-pop latency.
+ */
+namespace {
+    struct Sample {
+        bench::Clock::time_point sentAt;
+        GameEvent event;
+    };
+
+    constexpr auto RunTime = std::chrono::milliseconds(500);
+
+    template<typename Queue>
+    void runAtRate(const char *name, const int eventsPerSecond) {
+        Queue queue;
+        const auto total = static_cast<std::size_t>(eventsPerSecond * RunTime.count() / 1000);
+        const auto interval = std::chrono::nanoseconds(1'000'000'000LL / eventsPerSecond);
+        const nlohmann::json payload = {{"type", "PLAYER_MOVED"}, {"payload", {{"x", 1}, {"y", 2}, {"z", 0}}}};
+
+        std::vector<double> enqueueCost;
+        std::vector<double> latency;
+        enqueueCost.reserve(total);
+        latency.reserve(total);
+
+        std::thread consumer([&] {
+            Sample sample{{}, GameEvent(EventType::UNKNOWN, nullptr)};
+            std::size_t received = 0;
+            while (received < total) {
+                if (queue.tryPop(sample)) {
+                    latency.push_back(bench::nanosBetween(sample.sentAt, bench::Clock::now()));
+                    ++received;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        auto next = bench::Clock::now();
+        for (std::size_t i = 0; i < total; ++i) {
+            while (bench::Clock::now() < next) {
+            }
+            next += interval;
+            Sample sample{{}, GameEvent(EventType::PLAYER_MOVED, payload)};
+            const auto before = bench::Clock::now();
+            sample.sentAt = before;
+            queue.enqueue(std::move(sample));
+            enqueueCost.push_back(bench::nanosBetween(before, bench::Clock::now()));
+        }
+        consumer.join();
+
+        char label[64];
+        std::snprintf(label, sizeof(label), "%s enqueue @%dk/s", name, eventsPerSecond / 1000);
+        bench::printStats(label, bench::summarize(enqueueCost));
+        std::snprintf(label, sizeof(label), "%s latency @%dk/s", name, eventsPerSecond / 1000);
+        bench::printStats(label, bench::summarize(latency));
+    }
+}
+
+int main() {
+    for (const int rate: {10'000, 25'000, 50'000, 100'000}) {
+        runAtRate<BlockingQueue<Sample> >("BlockingQueue", rate);
+        runAtRate<SpscQueue<Sample> >("SpscQueue", rate);
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <cctype>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <ftxui/dom/elements.hpp>
+#include <ftxui/screen/screen.hpp>
+
+#include "BenchHarness.h"
+#include "game/GameState.h"
+#include "ui/ScreenDiff.h"
+#include "ui/TuiRenderer.h"
+#include "utils/Utf8.h"
+
+using namespace ftxui;
+
+/**
+ * Terminal output per frame while the player walks across the map, comparing the
+ * previous full screen.Print() after a cursor reset with the ScreenDiff output.
+ *
+ * The diff output is replayed into a small terminal model after every frame and must
+ * reproduce the frame's glyphs, otherwise the executable exits with a non-zero status.
+ */
+namespace {
+    constexpr int RangeX = 77;
+    constexpr int RangeY = 20;
+    constexpr int TerminalWidth = 170;
+    constexpr int TerminalHeight = 54;
+    constexpr int Steps = 60;
+
+    std::string glyphAt(const int x, const int y) {
+        static const char *glyphs[] = {".", ".", "#", " ", ".", "│", "─", ".", "┌", "┐", ".", " "};
+        return glyphs[static_cast<unsigned>(x * 7 + y * 13) % 12];
+    }
+
+    dto::MapDataResponse mapAround(const int centerX, const int centerY) {
+        dto::MapDataResponse map;
+        map.mapName = "Hlavni nadrazi";
+        map.centerX = centerX;
+        map.centerY = centerY;
+        map.rangeX = RangeX;
+        map.rangeY = RangeY;
+        auto &rows = map.layers["0"];
+        for (int y = centerY - RangeY; y <= centerY + RangeY; ++y) {
+            std::string row;
+            for (int x = centerX - RangeX; x <= centerX + RangeX; ++x) row += glyphAt(x, y);
+            rows.push_back(std::move(row));
+        }
+        return map;
+    }
+
+    /**
+     * @brief Glyph grid of a terminal fed with the subset of VT sequences ScreenDiff emits.
+     */
+    class TerminalModel {
+    public:
+        TerminalModel() : cells(TerminalHeight, std::vector<std::string>(TerminalWidth, " ")) {
+        }
+
+        bool feed(const std::string &out) {
+            for (std::size_t i = 0; i < out.size();) {
+                if (out[i] != '\033') {
+                    const std::size_t length = utils::Utf8::glyphLength(out, i);
+                    if (y >= TerminalHeight || x >= TerminalWidth) return false;
+                    cells[y][x++] = out.substr(i, length);
+                    i += length;
+                    continue;
+                }
+                if (i + 1 >= out.size() || out[i + 1] != '[') return false;
+                std::size_t end = i + 2;
+                while (end < out.size() && !std::isalpha(static_cast<unsigned char>(out[end]))) ++end;
+                if (end == out.size()) return false;
+                const std::string params = out.substr(i + 2, end - i - 2);
+                switch (out[end]) {
+                    case 'H': {
+                        const std::size_t semicolon = params.find(';');
+                        y = std::stoi(params.substr(0, semicolon)) - 1;
+                        x = std::stoi(params.substr(semicolon + 1)) - 1;
+                        break;
+                    }
+                    case 'C': x += params.empty() ? 1 : std::stoi(params); break;
+                    case 'J': for (auto &row: cells) row.assign(TerminalWidth, " "); break;
+                    case 'm': break;
+                    default: return false;
+                }
+                i = end + 1;
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool shows(const Screen &screen) const {
+            for (int row = 0; row < screen.dimy(); ++row) {
+                for (int column = 0; column < screen.dimx(); ++column) {
+                    const std::string &character = screen.PixelAt(column, row).character;
+                    if (!character.empty() && cells[row][column] != character) return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        std::vector<std::vector<std::string> > cells;
+        int x = 0;
+        int y = 0;
+    };
+}
+
+int main() {
+    GameState state;
+    state.clientState = ClientState::PLAYING;
+    state.player.hp = 100;
+    state.player.maxHp = 100;
+    dto::NpcsUpdateResponse npcs(20);
+    for (std::size_t i = 0; i < npcs.size(); ++i) {
+        npcs[i].name = "npc";
+        npcs[i].aggressive = i % 3 == 0;
+    }
+
+    TuiRenderer renderer;
+    ScreenDiff screenDiff;
+    TerminalModel terminal;
+    std::string output;
+    std::size_t fullBytes = 0;
+    std::size_t diffBytes = 0;
+    std::size_t firstDiffBytes = 0;
+    std::vector<double> fullNs;
+    std::vector<double> diffNs;
+
+    for (int step = 0; step < Steps; ++step) {
+        const int playerX = 500 + step;
+        const int playerY = 300 + step / 3;
+        state.updateMap(mapAround(playerX, playerY));
+        state.player.x = playerX;
+        state.player.y = playerY;
+        for (std::size_t i = 0; i < npcs.size(); ++i) {
+            npcs[i].x = 440 + static_cast<int>(i) * 6 + step % 4;
+            npcs[i].y = 290 + static_cast<int>(i);
+        }
+        state.updateNpcs(npcs);
+        if (step % 10 == 0) state.addGameLog("step " + std::to_string(step));
+
+        auto screen = Screen::Create(Dimension::Fixed(TerminalWidth), Dimension::Fixed(TerminalHeight));
+        Render(screen, renderer.buildFrame(state));
+
+        auto start = bench::Clock::now();
+        const std::string full = screen.ResetPosition() + screen.ToString();
+        fullNs.push_back(bench::nanosBetween(start, bench::Clock::now()));
+
+        output.clear();
+        start = bench::Clock::now();
+        screenDiff.diff(screen, output);
+        diffNs.push_back(bench::nanosBetween(start, bench::Clock::now()));
+
+        if (!terminal.feed(output) || !terminal.shows(screen)) {
+            std::printf("step %d: diff output does not reproduce the frame\n", step);
+            return 1;
+        }
+        if (step == 0) {
+            firstDiffBytes = output.size();
+        } else {
+            fullBytes += full.size();
+            diffBytes += output.size();
+        }
+    }
+
+    const bench::Stats full = bench::summarize(fullNs);
+    const bench::Stats diff = bench::summarize(diffNs);
+    std::printf("scripted walk, %d steps on a %dx%d terminal\n", Steps, TerminalWidth, TerminalHeight);
+    std::printf("  first frame          diff %8zu B\n", firstDiffBytes);
+    std::printf("  bytes per frame      full %8zu B   diff %8zu B   %.1fx fewer\n",
+                fullBytes / (Steps - 1), diffBytes / (Steps - 1),
+                static_cast<double>(fullBytes) / static_cast<double>(diffBytes));
+    std::printf("  encode time p50      full %8.0fns  diff %8.0fns\n", full.p50, diff.p50);
+    return 0;
+}
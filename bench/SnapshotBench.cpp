@@ -0,0 +1,107 @@
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "event/TripleBuffer.h"
+#include "game/GameState.h"
+
+/**
+ * Cost of publishing a RenderSnapshot, which is now the only time the controller
+ * holds the state mutex on behalf of rendering, on a state with a 155x81 map in
+ * three layers, NPCs and full logs.
+ *
+ * Also runs a writer publishing as fast as it can against a reader that refreshes
+ * and checks every snapshot it gets, to report how many snapshots a slow reader
+ * skips. Exits with a non-zero status if the reader ever sees a torn snapshot.
+ */
+namespace {
+    constexpr int RangeX = 77;
+    constexpr int RangeY = 40;
+
+    void populate(GameState &state) {
+        static const char *glyphs[] = {".", ".", "#", ",", ".", "│", "─", ".", ":", "~", ".", "┌"};
+        dto::MapDataResponse map;
+        map.mapName = "Hlavni nadrazi";
+        map.centerX = 500;
+        map.centerY = 300;
+        map.rangeX = RangeX;
+        map.rangeY = RangeY;
+        for (const char *layer: {"-1", "0", "1"}) {
+            auto &rows = map.layers[layer];
+            for (int y = 0; y <= 2 * RangeY; ++y) {
+                std::string row;
+                for (int x = 0; x <= 2 * RangeX; ++x) row += glyphs[(x * 7 + y * 13) % 12];
+                rows.push_back(std::move(row));
+            }
+        }
+        state.updateMap(std::move(map));
+        dto::NpcsUpdateResponse npcs;
+        for (int i = 0; i < 40; ++i) {
+            dto::NpcDto npc;
+            npc.name = "npc " + std::to_string(i);
+            npc.x = 440 + i * 3;
+            npc.y = 290 + i % 20;
+            npcs.push_back(npc);
+        }
+        state.updateNpcs(std::move(npcs));
+        for (int i = 0; i < 8; ++i) {
+            state.addGameLog("Log line number " + std::to_string(i));
+            const std::string_view frame = R"({"x":500,"y":300,"z":0})";
+            state.addNetworkLog("IN", "SEND_PLAYER_POSITION", nullptr, frame.size(), frame);
+        }
+    }
+
+    /** @brief Publishes the state; player.x carries the version so the reader can spot torn copies. */
+    void publish(TripleBuffer<RenderSnapshot> &snapshots, GameState &state) {
+        state.markDirty();
+        state.player.x = static_cast<int>(state.getVersion());
+        RenderSnapshot &snapshot = snapshots.writeSlot();
+        snapshot.version = state.getVersion();
+        snapshot.view = static_cast<const GameView &>(state);
+        snapshots.publish();
+    }
+}
+
+int main() {
+    GameState state;
+    populate(state);
+
+    TripleBuffer<RenderSnapshot> snapshots;
+    const double publishNs = bench::timePerCall(2000, [&] { publish(snapshots, state); });
+    std::printf("publish RenderSnapshot (3 layers %dx%d)   %10.0fns\n", 2 * RangeX + 1, 2 * RangeY + 1, publishNs);
+
+    // The reader plays a renderer that needs about a millisecond per frame.
+    std::atomic<bool> writing{true};
+    std::size_t published = 0;
+    std::thread writer([&] {
+        while (writing) {
+            publish(snapshots, state);
+            ++published;
+        }
+    });
+
+    std::size_t read = 0;
+    bool torn = false;
+    const auto end = bench::Clock::now() + std::chrono::milliseconds(500);
+    while (bench::Clock::now() < end) {
+        if (snapshots.refresh()) {
+            const RenderSnapshot &snapshot = snapshots.readSlot();
+            torn |= snapshot.view.player.x != static_cast<int>(snapshot.version);
+            ++read;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    writing = false;
+    writer.join();
+
+    std::printf("snapshots published %zu, drawn %zu, skipped %zu\n", published, read, published - read);
+    if (torn) {
+        std::printf("reader saw a torn snapshot\n");
+        return 1;
+    }
+    return 0;
+}
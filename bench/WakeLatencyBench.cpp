@@ -0,0 +1,76 @@
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "event/SpscQueue.h"
+#include "event/WakeSignal.h"
+
+/**
+ * Compares the old main loop, which slept 16 ms between passes, with the reactor
+ * loop blocking on a WakeSignal notified by the inbound queue.
+ *
+ * A producer thread pushes timestamps at a low, irregular rate like server updates
+ * and key presses; the loop records push-to-pickup latency and how many times it
+ * woke up, i.e. what it costs while idle.
+ */
+namespace {
+    constexpr auto RunTime = std::chrono::milliseconds(2000);
+    constexpr auto FrameDeadline = std::chrono::milliseconds(250);
+    constexpr int EventsPerSecond = 20;
+
+    struct Result {
+        bench::Stats latency;
+        std::size_t wakeups = 0;
+    };
+
+    template<typename WaitFn>
+    Result run(SpscQueue<bench::Clock::time_point> &queue, WaitFn &&waitForWork) {
+        std::atomic<bool> producing{true};
+        std::thread producer([&] {
+            unsigned jitter = 1;
+            while (producing) {
+                jitter = jitter * 1103515245u + 12345u;
+                std::this_thread::sleep_for(std::chrono::microseconds(1'000'000 / EventsPerSecond + jitter % 7000));
+                queue.enqueue(bench::Clock::now());
+            }
+        });
+
+        Result result;
+        std::vector<double> latency;
+        const auto end = bench::Clock::now() + RunTime;
+        while (bench::Clock::now() < end) {
+            waitForWork();
+            ++result.wakeups;
+            bench::Clock::time_point sentAt;
+            while (queue.tryPop(sentAt)) {
+                latency.push_back(bench::nanosBetween(sentAt, bench::Clock::now()));
+            }
+        }
+        producing = false;
+        producer.join();
+        bench::Clock::time_point sentAt;
+        while (queue.tryPop(sentAt)) {
+        }
+        result.latency = bench::summarize(latency);
+        return result;
+    }
+
+    void print(const char *name, const Result &result) {
+        bench::printStats(name, result.latency);
+        std::printf("%-40s %.0f wakeups per second\n", "",
+                    static_cast<double>(result.wakeups) * 1000.0 / static_cast<double>(RunTime.count()));
+    }
+}
+
+int main() {
+    SpscQueue<bench::Clock::time_point> polled;
+    print("sleep 16 ms loop", run(polled, [] { std::this_thread::sleep_for(std::chrono::milliseconds(16)); }));
+
+    SpscQueue<bench::Clock::time_point> notified;
+    WakeSignal wakeSignal;
+    notified.setNotifier([&wakeSignal] { wakeSignal.notify(); });
+    print("WakeSignal loop", run(notified, [&wakeSignal] { wakeSignal.waitUntil(bench::Clock::now() + FrameDeadline); }));
+    return 0;
+}
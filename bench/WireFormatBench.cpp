@@ -0,0 +1,135 @@
+#include <cstdio>
+#include <string>
+
+#include "BenchHarness.h"
+#include "event/GameEvent.h"
+#include "network/WireFormat.h"
+
+/**
+ * Compares the JSON text, MessagePack and CBOR wire formats on representative
+ * server frames: bytes per frame, the DOM decode alone, and the full parseEvent
+ * path the network thread runs (streaming decode for hot types).
+ *
+ * Envelopes are written type-first, in the field order a server serializing its
+ * message classes produces.
+ */
+namespace {
+    using ordered_json = nlohmann::ordered_json;
+
+    std::string encode(const ordered_json &frame, const WireFormat format) {
+        std::string out;
+        switch (format) {
+            case WireFormat::MSGPACK: ordered_json::to_msgpack(frame, out); break;
+            case WireFormat::CBOR: ordered_json::to_cbor(frame, out); break;
+            default: out = frame.dump(); break;
+        }
+        return out;
+    }
+
+    ordered_json envelope(const char *type, ordered_json payload) {
+        ordered_json root;
+        root["type"] = type;
+        root["payload"] = std::move(payload);
+        return root;
+    }
+
+    ordered_json mapFrame() {
+        constexpr int Rows = 80;
+        constexpr int Columns = 154;
+        const char tiles[] = "#..,.:~..#=..";
+        ordered_json payload;
+        payload["mapName"] = "Hlavni nadrazi";
+        payload["centerX"] = Columns / 2;
+        payload["centerY"] = Rows / 2;
+        payload["rangeX"] = Columns / 2;
+        payload["rangeY"] = Rows / 2;
+        for (const char *layerName: {"-1", "0", "1"}) {
+            ordered_json layer = ordered_json::array();
+            for (int y = 0; y < Rows; ++y) {
+                std::string row;
+                for (int x = 0; x < Columns; ++x) {
+                    row += tiles[(x * 7 + y * 3) % (sizeof(tiles) - 1)];
+                }
+                layer.push_back(row);
+            }
+            payload["layers"][layerName] = std::move(layer);
+        }
+        return envelope("MAP_DATA", std::move(payload));
+    }
+
+    ordered_json npcsFrame() {
+        ordered_json npcs = ordered_json::array();
+        for (int i = 0; i < 100; ++i) {
+            ordered_json npc;
+            npc["id"] = "npc-" + std::to_string(i);
+            npc["name"] = i % 3 ? "Mutated Rat" : "Metro Trader Vasek";
+            npc["type"] = i % 3 ? "MUTANT" : "HUMAN";
+            npc["x"] = i % 154;
+            npc["y"] = i / 154;
+            npc["z"] = 0;
+            npc["hp"] = 40;
+            npc["maxHp"] = 40;
+            npc["aggressive"] = i % 3 != 0;
+            npc["interaction"] = i % 3 ? "ATTACK" : "TRADE";
+            npcs.push_back(std::move(npc));
+        }
+        return envelope("NPCS_UPDATE", std::move(npcs));
+    }
+
+    ordered_json statsFrame() {
+        ordered_json stats;
+        stats["hp"] = 87;
+        stats["maxHp"] = 100;
+        stats["rads"] = 12;
+        stats["credits"] = 1540;
+        stats["debt"] = 25000;
+        stats["globalDebt"] = 12345678901LL;
+        stats["equippedWeaponSlot"] = 2;
+        stats["equippedMaskSlot"] = nullptr;
+        return envelope("STATS_UPDATE", std::move(stats));
+    }
+
+    ordered_json positionFrame() {
+        ordered_json position;
+        position["x"] = 71;
+        position["y"] = 33;
+        position["z"] = 0;
+        return envelope("SEND_PLAYER_POSITION", std::move(position));
+    }
+}
+
+int main() {
+    std::size_t sink = 0;
+    const struct {
+        const char *name;
+        ordered_json frame;
+        std::size_t iterations;
+    } frames[] = {
+        {"MAP_DATA", mapFrame(), 200},
+        {"NPCS_UPDATE x100", npcsFrame(), 2000},
+        {"STATS_UPDATE", statsFrame(), 100000},
+        {"SEND_PLAYER_POSITION", positionFrame(), 100000},
+    };
+
+    std::printf("%-20s %-8s %9s %8s %14s %14s\n", "frame", "format", "bytes", "vs JSON", "DOM decode", "parseEvent");
+    for (const auto &[name, frame, iterations]: frames) {
+        const std::size_t jsonBytes = encode(frame, WireFormat::JSON).size();
+        for (const WireFormat format: {WireFormat::JSON, WireFormat::MSGPACK, WireFormat::CBOR}) {
+            const std::string bytes = encode(frame, format);
+            if (parseEvent(bytes, format).getType() == EventType::UNKNOWN) {
+                std::printf("%s did not decode as %s\n", name, wireFormatName(format));
+                return 1;
+            }
+
+            const double dom = bench::timePerCall(iterations, [&] {
+                sink += decodeFrame(bytes, format).size();
+            });
+            const double event = bench::timePerCall(iterations, [&] {
+                sink += static_cast<std::size_t>(parseEvent(bytes, format).getType());
+            });
+            std::printf("%-20s %-8s %9zu %7.0f%% %12.0fns %12.0fns\n", name, wireFormatName(format), bytes.size(),
+                        100.0 * static_cast<double>(bytes.size()) / static_cast<double>(jsonBytes), dom, event);
+        }
+    }
+    return sink == 0;
+}
@@ -1,26 +1,110 @@
 #include "Application.h"
-#include <thread>
-#include <chrono>
+#include <algorithm>
+#include <string>
 
 #include "network/NetworkSender.h"
+#include "utils/DtoPool.h"
+#include "utils/FrameArena.h"
+#include "utils/Logger.h"
 
-Application::Application(const std::string &url) {
-    this->fromServerToClient = std::make_unique<BlockingQueue<GameEvent> >();
-    this->fromClientToServer = std::make_unique<BlockingQueue<GameEvent> >();
-    this->networkHandler = std::make_unique<NetworkHandler>(url, fromServerToClient.get());
-    this->gameController = std::make_unique<GameController>(fromServerToClient.get(), fromClientToServer.get());
-    this->inputHandler = std::make_unique<InputHandler>(fromClientToServer.get());
+Application::Application(const std::string &url, const ApplicationOptions &options) {
+    this->schedule = options.schedule;
+    if (!options.capturePath.empty()) {
+        this->frameCapture = std::make_unique<FrameCapture>(options.capturePath);
+        if (!frameCapture->isOpen()) {
+            Logger::log(LogLevel::WARNING, "NET", "Cannot open capture file " + options.capturePath);
+            frameCapture.reset();
+        }
+    }
+    this->fromServerToClient = std::make_unique<SpscQueue<GameEvent> >();
+    this->fromClientToServer = std::make_unique<SpscQueue<GameEvent> >();
+    this->keyQueue = std::make_unique<KeyQueue>();
+    this->wakeSignal = std::make_unique<WakeSignal>();
+    // Both notifiers must be set before the producer threads start.
+    this->fromServerToClient->setNotifier([signal = wakeSignal.get()] { signal->notify(); });
+    this->keyQueue->setNotifier([signal = wakeSignal.get()] { signal->notify(); });
+    this->networkHandler = std::make_unique<NetworkHandler>(url, fromServerToClient.get(), frameCapture.get());
+    if (!options.replayPath.empty()) {
+        // The handler is still needed by the sender, but never connects; what the
+        // client sends goes nowhere.
+        this->frameReplay = std::make_unique<FrameReplay>(options.replayPath, fromServerToClient.get(),
+                                                          options.replayAsFastAsPossible);
+    }
+    this->renderThread = std::make_unique<RenderThread>(schedule);
+    this->gameController = std::make_unique<GameController>(fromServerToClient.get(), fromClientToServer.get(),
+                                                             renderThread.get(), options.historyDepth);
+    this->inputHandler = std::make_unique<InputHandler>(fromClientToServer.get(), keyQueue.get());
+    const auto pollInterval = std::chrono::microseconds(1'000'000 / std::max(1, schedule.inputHz));
+    this->keyboardReader = std::make_unique<KeyboardReader>(keyQueue.get(), pollInterval);
     this->inputHandler->setGameController(gameController.get());
-    this->networkSender = std::make_unique<NetworkSender>(fromClientToServer.get(), networkHandler.get());
+    this->networkSender = std::make_unique<NetworkSender>(fromClientToServer.get(), networkHandler.get(),
+                                                         options.captureOutbound ? frameCapture.get() : nullptr);
 }
 
 void Application::execute() const {
-    networkHandler->start();
+    if (frameReplay) {
+        frameReplay->start();
+    } else {
+        networkHandler->start();
+    }
     networkSender->start();
+    keyboardReader->start();
+    renderThread->start();
 
+    TickScheduler scheduler(schedule);
     while (gameController->isRunning()) {
+        const auto now = TickScheduler::Clock::now();
+        // Input is handled on every wake-up, whatever the network and render rates.
         gameController->handleInput(*inputHandler);
-        gameController->update();
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+        if (!gameController->isRunning()) {
+            break;
+        }
+        if (scheduler.networkDue(now)) {
+            gameController->drainEvents();
+            scheduler.networkDrained(now);
+        }
+        wakeSignal->waitUntil(scheduler.nextWake(now));
+    }
+    keyboardReader->stop();
+    renderThread->stop();
+    if (frameReplay) {
+        frameReplay->stop();
+    }
+
+    if (Logger::enabled(LogLevel::INFO)) {
+        const RenderStats stats = renderThread->getStats();
+        Logger::log(LogLevel::INFO, "RENDER", "Frames drawn: " + std::to_string(stats.budget.framesDrawn)
+                                              + " skipped: " + std::to_string(stats.framesSkipped)
+                                              + " dropped: " + std::to_string(stats.framesDropped)
+                                              + " over budget: " + std::to_string(stats.budget.framesOverBudget)
+                                              + " p50/p95/p99/max: " + std::to_string(stats.p50FrameMicros)
+                                              + "/" + std::to_string(stats.p95FrameMicros)
+                                              + "/" + std::to_string(stats.p99FrameMicros)
+                                              + "/" + std::to_string(stats.budget.maxRenderMicros) + "us"
+                                              + " budget: " + std::to_string(stats.budget.budgetMicros) + "us"
+                                              + " bytes written: " + std::to_string(stats.bytesWritten));
+
+        const SenderStats sent = networkSender->getStats();
+        const uint64_t events = std::max<uint64_t>(1, sent.eventsSent);
+        const uint64_t batches = std::max<uint64_t>(1, sent.batchesSent);
+        Logger::log(LogLevel::INFO, "NET", "Events sent: " + std::to_string(sent.eventsSent)
+                                           + " frames: " + std::to_string(sent.framesSent)
+                                           + " batches: " + std::to_string(sent.batchesSent)
+                                           + " queue wait avg/max: " + std::to_string(sent.queueWaitMicros / events)
+                                           + "/" + std::to_string(sent.maxQueueWaitMicros) + "us"
+                                           + " send avg/max: " + std::to_string(sent.sendMicros / batches)
+                                           + "/" + std::to_string(sent.maxSendMicros) + "us");
+
+        const utils::FrameArenaStats arena = utils::FrameArena::getStats();
+        const utils::DtoPoolStats npcPool = utils::DtoPool<dto::NpcsUpdateResponse>::getStats();
+        const utils::DtoPoolStats playerPool = utils::DtoPool<dto::OtherPlayersUpdateResponse>::getStats();
+        Logger::log(LogLevel::INFO, "MEMORY", "DOM frames: " + std::to_string(arena.frames)
+                                              + " arena allocations: " + std::to_string(arena.allocations)
+                                              + " heap blocks: " + std::to_string(arena.blockAllocations)
+                                              + " peak frame: " + std::to_string(arena.peakFrameBytes) + "B"
+                                              + " NPC lists reused: " + std::to_string(npcPool.reused)
+                                              + "/" + std::to_string(npcPool.taken)
+                                              + " player lists reused: " + std::to_string(playerPool.reused)
+                                              + "/" + std::to_string(playerPool.taken));
     }
 }
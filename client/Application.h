@@ -1,11 +1,34 @@
 #ifndef APPLICATION_H
 #define APPLICATION_H
-#include "event/BlockingQueue.h"
+#include "event/SpscQueue.h"
 #include "event/GameEvent.h"
+#include "event/WakeSignal.h"
 #include "game/GameController.h"
+#include "game/TickScheduler.h"
 #include "input/InputHandler.h"
+#include "input/KeyboardReader.h"
 #include "network/NetworkHandler.h"
+#include "network/FrameReplay.h"
 #include "network/NetworkSender.h"
+#include "ui/RenderThread.h"
+
+/**
+ * @brief Settings of the Application that come from the command line.
+ */
+struct ApplicationOptions {
+    /** @brief Input, network and render rates. */
+    ScheduleConfig schedule;
+    /** @brief Chat, game log and network log lines kept for scrolling back. */
+    std::size_t historyDepth = GameState::DefaultHistoryDepth;
+    /** @brief File receiving the captured frames, see FrameCapture; empty for none. */
+    std::string capturePath;
+    /** @brief Capture sent frames too (--capture); --record keeps only what NetworkHandler receives. */
+    bool captureOutbound = true;
+    /** @brief Recording to play instead of connecting to a server; empty to connect. */
+    std::string replayPath;
+    /** @brief Replay without the recorded pauses between frames. */
+    bool replayAsFastAsPossible = false;
+};
 
 /**
  * @brief The main entry point of the client application.
@@ -15,11 +38,23 @@
  */
 class Application {
 private:
+    /** @brief Full-frame capture file, null unless requested. Declared first so the network threads stop before it closes. */
+    std::unique_ptr<FrameCapture> frameCapture;
+
     /** @brief Queue for events received from the server to be processed by the client. */
-    std::unique_ptr<BlockingQueue<GameEvent> > fromServerToClient;
+    std::unique_ptr<SpscQueue<GameEvent> > fromServerToClient;
 
     /** @brief Queue for events generated by the client to be sent to the server. */
-    std::unique_ptr<BlockingQueue<GameEvent> > fromClientToServer;
+    std::unique_ptr<SpscQueue<GameEvent> > fromClientToServer;
+
+    /** @brief Keys read by the keyboard thread, waiting for the main loop. */
+    std::unique_ptr<KeyQueue> keyQueue;
+
+    /** @brief The main loop blocks on this; inbound events and key presses notify it. */
+    std::unique_ptr<WakeSignal> wakeSignal;
+
+    /** @brief Reads the console keyboard on its own thread. */
+    std::unique_ptr<KeyboardReader> keyboardReader;
 
     /** @brief Handles user input from the keyboard. */
     std::unique_ptr<InputHandler> inputHandler;
@@ -27,24 +62,35 @@ private:
     /** @brief Manages the WebSocket connection and incoming messages. */
     std::unique_ptr<NetworkHandler> networkHandler;
 
+    /** @brief Feeds a recording into the input queue in place of the server, null when connected. */
+    std::unique_ptr<FrameReplay> frameReplay;
+
+    /** @brief Draws the game state on its own thread. */
+    std::unique_ptr<RenderThread> renderThread;
+
     /** @brief Controls the game state and logic. */
     std::unique_ptr<GameController> gameController;
 
     /** @brief Consumes events from the output queue and sends them over the network. */
     std::unique_ptr<NetworkSender> networkSender;
 
+    /** @brief Rates of the main loop tasks. */
+    ScheduleConfig schedule;
+
 public:
     /**
      * @brief Constructs the Application and initializes all components.
-     * @param url The WebSocket URL of the game server.
+     * @param url The WebSocket URL of the game server; not connected to when replaying.
+     * @param options Rates, history depth, capture and replay files.
      */
-    explicit Application(const std::string &url);
+    explicit Application(const std::string &url, const ApplicationOptions &options = {});
 
     /**
      * @brief Starts the application loop.
      *
-     * This method starts the network threads and enters the main game loop,
-     * processing input and updating the game state until the application is closed.
+     * This method starts the network (or replay), keyboard and render threads and enters the main game
+     * loop, which sleeps until an inbound event, a key press or a TickScheduler
+     * deadline wakes it, until the application is closed.
      */
     void execute() const;
 };
@@ -15,5 +15,7 @@ const std::string ACTION_DROP = "DROP";
 const std::string ACTION_BUY = "BUY";
 const std::string ACTION_SELL = "SELL";
 const std::string ACTION_TRAVEL = "TRAVEL";
+const std::string ACTION_MAP_RESYNC = "MAP_RESYNC";
+const std::string ACTION_PAY_DEBT = "PAY_DEBT";
 
 #endif //GAMEEVENTTYPES_H
@@ -81,6 +81,12 @@ namespace dto {
 
         [[nodiscard]] std::string getType() const override { return ACTION_TRAVEL; }
     };
+
+    struct PayDebtRequest : GameRequest {
+        int amount;
+
+        [[nodiscard]] std::string getType() const override { return ACTION_PAY_DEBT; }
+    };
 }
 
 #endif //GAMEREQUESTS_H
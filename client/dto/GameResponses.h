@@ -1,9 +1,14 @@
 #ifndef GAMERESPONSES_H
 #define GAMERESPONSES_H
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
+#include <optional>
+#include <variant>
 
 namespace dto {
 
@@ -87,6 +92,10 @@ namespace dto {
     struct LoginOptionsResponse {
         std::vector<std::string> classes;
         std::vector<MapInfo> maps;
+        /** @brief Optional protocol features the server advertises in the envelope, e.g. "BATCH". */
+        std::vector<std::string> capabilities;
+        /** @brief Wire format the server picked from the INIT offer; empty keeps JSON text. */
+        std::string encoding;
     };
 
     struct MapDataResponse {
@@ -99,6 +108,41 @@ namespace dto {
         std::map<std::string, std::vector<std::string> > layers;
     };
 
+    /**
+     * @brief One newly revealed map row or column.
+     *
+     * For a row, index is the world y and tiles runs left to right across the viewport;
+     * for a column, index is the world x and tiles runs top to bottom.
+     */
+    struct MapStripDto {
+        int index = 0;
+        std::string tiles;
+    };
+
+    /** @brief A single tile that changed inside the viewport. */
+    struct TileChangeDto {
+        int x = 0;
+        int y = 0;
+        int z = 0;
+        std::string glyph;
+    };
+
+    /**
+     * @brief Incremental update of the stored map viewport.
+     *
+     * Only valid on top of the viewport centered at baseX/baseY; the viewport size and
+     * the layers stay the same. Strips are keyed by layer like MapDataResponse::layers.
+     */
+    struct MapDeltaResponse {
+        int baseX = 0;
+        int baseY = 0;
+        int centerX = 0;
+        int centerY = 0;
+        std::map<std::string, std::vector<MapStripDto> > rows;
+        std::map<std::string, std::vector<MapStripDto> > columns;
+        std::vector<TileChangeDto> tiles;
+    };
+
     using NpcsUpdateResponse = std::vector<NpcDto>;
 
     struct MetroUiResponse {
@@ -119,17 +163,103 @@ namespace dto {
         std::string message;
     };
 
+    /**
+     * @brief One entry of the in-game network log.
+     *
+     * Recorded for every frame, so it holds only what is cheap to take: static
+     * names, the frame size and the first bytes of a text frame. The text shown in
+     * the log panel is built from it when the entry is drawn.
+     */
     struct NetworkLogDto {
-        std::string timestamp;
-        std::string direction;
-        std::string type;
-        std::string payload;
+        /** @brief Bytes of a text frame kept for the log panel. */
+        static constexpr std::size_t PreviewLength = 60;
+
+        std::chrono::system_clock::time_point timestamp;
+        const char *direction = "IN"; ///< "IN" or "OUT"; static string.
+        const char *type = "";        ///< Event type name; static string.
+        /** @brief Protocol name of a binary frame, e.g. "MSGPACK"; null for JSON text. Static string. */
+        const char *encoding = nullptr;
+        std::size_t size = 0;
+        std::array<char, PreviewLength> preview{};
+        std::uint8_t previewLength = 0;
     };
 
     struct DialogResponse {
         std::string npcName;
         std::string text;
     };
+
+    /**
+     * @brief Partial stats update; only the fields present in the message are set.
+     */
+    struct StatsUpdateResponse {
+        std::optional<int> hp;
+        std::optional<int> maxHp;
+        std::optional<int> rads;
+        std::optional<int> credits;
+        std::optional<int> debt;
+        std::optional<long> globalDebt;
+        std::optional<std::string> equippedWeaponSlot;
+        std::optional<std::string> equippedMaskSlot;
+    };
+
+    /**
+     * @brief Partial position update; only the coordinates present in the message are set.
+     */
+    struct PlayerPositionResponse {
+        std::optional<int> x;
+        std::optional<int> y;
+        std::optional<int> z;
+    };
+
+    struct InventoryUpdateResponse {
+        std::map<int, ItemDto> slots;
+    };
+
+    using OtherPlayersUpdateResponse = std::vector<OtherPlayerDto>;
+
+    /**
+     * @brief Plain text payload of SEND_MESSAGE, SEND_ERROR and GLOBAL_ANNOUNCEMENT.
+     */
+    struct TextMessageResponse {
+        std::string text;
+    };
+
+    struct GameOverResponse {
+    };
+
+    /**
+     * @brief Produced instead of a payload when the envelope itself is unusable
+     * (unknown type, missing payload). Shown as the connection status.
+     */
+    struct StatusResponse {
+        std::string status;
+    };
+
+    /**
+     * @brief A fully decoded server message, built on the network thread.
+     *
+     * std::monostate means there is nothing to apply (null payload, outbound event).
+     */
+    using ServerMessage = std::variant<
+        std::monostate,
+        StatusResponse,
+        LoginOptionsResponse,
+        MapDataResponse,
+        MapDeltaResponse,
+        StatsUpdateResponse,
+        InventoryUpdateResponse,
+        PlayerPositionResponse,
+        NpcsUpdateResponse,
+        MapObjectsUpdateResponse,
+        OtherPlayersUpdateResponse,
+        ChatMessageResponse,
+        MetroUiResponse,
+        TradeUiLoadResponse,
+        DialogResponse,
+        TextMessageResponse,
+        GameOverResponse
+    >;
 }
 
 #endif //GAMERESPONSES_H
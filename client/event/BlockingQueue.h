@@ -37,7 +37,7 @@ public:
     T take() {
         std::unique_lock lock(_mutex);
         _cond.wait(lock, [this] { return !_queue.empty(); });
-        const T item = std::move(_queue.front());
+        T item = std::move(_queue.front());
         _queue.pop();
         return item;
     }
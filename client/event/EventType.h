@@ -1,6 +1,9 @@
 #ifndef EVENTTYPE_H
 #define EVENTTYPE_H
-#include <map>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 
 enum class EventType {
     CONNECTION_ESTABLISHED,
@@ -23,32 +26,146 @@ enum class EventType {
     UNKNOWN,
     GLOBAL_ANNOUNCEMENT,
     PAY_DEBT,
-    DIALOG
+    DIALOG,
+    MAP_DELTA
 };
 
-static std::map<std::string, EventType> stringToType = {
-    {"SEND_LOGIN_OPTIONS", EventType::SEND_LOGIN_OPTIONS},
-    {"LOGIN_OPTIONS", EventType::SEND_LOGIN_OPTIONS},
-    {"SEND_MAP_DATA", EventType::SEND_MAP_DATA},
-    {"MAP_DATA", EventType::SEND_MAP_DATA},
-    {"SEND_STATS", EventType::SEND_STATS},
-    {"STATS_UPDATE", EventType::SEND_STATS},
-    {"SEND_INVENTORY", EventType::SEND_INVENTORY},
-    {"SEND_PLAYER_POSITION", EventType::SEND_PLAYER_POSITION},
-    {"PLAYER_MOVED", EventType::PLAYER_MOVED},
-    {"SEND_GAME_OVER", EventType::SEND_GAME_OVER},
-    {"SEND_NPCS", EventType::SEND_NPCS},
-    {"NPCS_UPDATE", EventType::SEND_NPCS},
-    {"SEND_MAP_OBJECTS", EventType::SEND_MAP_OBJECTS},
-    {"OPEN_METRO_UI", EventType::OPEN_METRO_UI},
-    {"OPEN_TRADE_UI", EventType::OPEN_TRADE_UI},
-    {"BROADCAST_CHAT_MSG", EventType::BROADCAST_CHAT_MSG},
-    {"SEND_MESSAGE", EventType::SEND_MESSAGE},
-    {"SEND_ERROR", EventType::SEND_ERROR},
-    {"BROADCAST_PLAYERS", EventType::BROADCAST_PLAYERS},
-    {"GLOBAL_ANNOUNCEMENT", EventType::GLOBAL_ANNOUNCEMENT},
-    {"PAY_DEBT", EventType::PAY_DEBT},
-    {"DIALOG", EventType::DIALOG}
-};
+/** @brief Number of EventType values; MAP_DELTA must stay the last one. */
+constexpr std::size_t EventTypeCount = static_cast<std::size_t>(EventType::MAP_DELTA) + 1;
+
+namespace detail {
+    struct WireTypeName {
+        std::string_view name;
+        EventType type;
+    };
+
+    /** @brief Type names the server sends, aliases included. */
+    constexpr WireTypeName WireTypeNames[] = {
+        {"SEND_LOGIN_OPTIONS", EventType::SEND_LOGIN_OPTIONS},
+        {"LOGIN_OPTIONS", EventType::SEND_LOGIN_OPTIONS},
+        {"SEND_MAP_DATA", EventType::SEND_MAP_DATA},
+        {"MAP_DATA", EventType::SEND_MAP_DATA},
+        {"SEND_STATS", EventType::SEND_STATS},
+        {"STATS_UPDATE", EventType::SEND_STATS},
+        {"SEND_INVENTORY", EventType::SEND_INVENTORY},
+        {"SEND_PLAYER_POSITION", EventType::SEND_PLAYER_POSITION},
+        {"PLAYER_MOVED", EventType::PLAYER_MOVED},
+        {"SEND_GAME_OVER", EventType::SEND_GAME_OVER},
+        {"SEND_NPCS", EventType::SEND_NPCS},
+        {"NPCS_UPDATE", EventType::SEND_NPCS},
+        {"SEND_MAP_OBJECTS", EventType::SEND_MAP_OBJECTS},
+        {"OPEN_METRO_UI", EventType::OPEN_METRO_UI},
+        {"OPEN_TRADE_UI", EventType::OPEN_TRADE_UI},
+        {"BROADCAST_CHAT_MSG", EventType::BROADCAST_CHAT_MSG},
+        {"SEND_MESSAGE", EventType::SEND_MESSAGE},
+        {"SEND_ERROR", EventType::SEND_ERROR},
+        {"BROADCAST_PLAYERS", EventType::BROADCAST_PLAYERS},
+        {"GLOBAL_ANNOUNCEMENT", EventType::GLOBAL_ANNOUNCEMENT},
+        {"PAY_DEBT", EventType::PAY_DEBT},
+        {"DIALOG", EventType::DIALOG},
+        {"MAP_DELTA", EventType::MAP_DELTA}
+    };
+
+    constexpr std::size_t WireTypeCount = sizeof(WireTypeNames) / sizeof(WireTypeNames[0]);
+    /** @brief Slots of the hash table; a power of two several times the name count keeps the seed search short. */
+    constexpr std::size_t WireTypeSlots = 128;
+    constexpr std::uint8_t EmptySlot = 0xFF;
+    constexpr std::uint32_t NoSeed = 0xFFFFFFFF;
+
+    /** @brief FNV-1a of the name, varied by the seed. */
+    constexpr std::uint32_t hashWireType(const std::string_view name, const std::uint32_t seed) {
+        std::uint32_t hash = 2166136261u ^ seed;
+        for (const char c: name) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+        }
+        return hash;
+    }
+
+    /** @brief Finds the first seed under which no two names share a slot. */
+    constexpr std::uint32_t findWireTypeSeed() {
+        for (std::uint32_t seed = 0; seed < 10000; ++seed) {
+            bool used[WireTypeSlots] = {};
+            bool collision = false;
+            for (std::size_t i = 0; i < WireTypeCount && !collision; ++i) {
+                const std::size_t slot = hashWireType(WireTypeNames[i].name, seed) % WireTypeSlots;
+                collision = used[slot];
+                used[slot] = true;
+            }
+            if (!collision) {
+                return seed;
+            }
+        }
+        return NoSeed;
+    }
+
+    constexpr std::uint32_t WireTypeSeed = findWireTypeSeed();
+    static_assert(WireTypeSeed != NoSeed, "no collision-free seed for the wire type names");
+
+    constexpr std::array<std::uint8_t, WireTypeSlots> buildWireTypeSlots() {
+        std::array<std::uint8_t, WireTypeSlots> slots{};
+        for (auto &slot: slots) {
+            slot = EmptySlot;
+        }
+        for (std::size_t i = 0; i < WireTypeCount; ++i) {
+            slots[hashWireType(WireTypeNames[i].name, WireTypeSeed) % WireTypeSlots] = static_cast<std::uint8_t>(i);
+        }
+        return slots;
+    }
+
+    /** @brief Index into WireTypeNames for each hash slot, EmptySlot where no name lands. */
+    constexpr std::array<std::uint8_t, WireTypeSlots> WireTypeSlotTable = buildWireTypeSlots();
+}
+
+/**
+ * @brief Resolves the "type" of a server frame.
+ *
+ * A perfect hash built at compile time: one hash of the name and one string
+ * compare, no allocation and no table to build at startup.
+ * @param name The type name as sent, e.g. "NPCS_UPDATE".
+ * @return The event type, or EventType::UNKNOWN for names the client does not know.
+ */
+constexpr EventType eventTypeFromName(const std::string_view name) {
+    const std::uint8_t index = detail::WireTypeSlotTable[
+        detail::hashWireType(name, detail::WireTypeSeed) % detail::WireTypeSlots];
+    if (index == detail::EmptySlot || detail::WireTypeNames[index].name != name) {
+        return EventType::UNKNOWN;
+    }
+    return detail::WireTypeNames[index].type;
+}
+
+static_assert(eventTypeFromName("NPCS_UPDATE") == EventType::SEND_NPCS);
+static_assert(eventTypeFromName("SEND_NOTHING") == EventType::UNKNOWN);
+
+/**
+ * @brief Returns the canonical wire name of an event type, used for logging.
+ * @param type The event type.
+ * @return The name; aliases such as "NPCS_UPDATE" map to their canonical name.
+ */
+inline const char *eventTypeName(const EventType type) {
+    switch (type) {
+        case EventType::CONNECTION_ESTABLISHED: return "CONNECTION_ESTABLISHED";
+        case EventType::SEND_LOGIN_OPTIONS: return "SEND_LOGIN_OPTIONS";
+        case EventType::SEND_MAP_DATA: return "SEND_MAP_DATA";
+        case EventType::SEND_STATS: return "SEND_STATS";
+        case EventType::SEND_INVENTORY: return "SEND_INVENTORY";
+        case EventType::SEND_PLAYER_POSITION: return "SEND_PLAYER_POSITION";
+        case EventType::PLAYER_MOVED: return "PLAYER_MOVED";
+        case EventType::SEND_GAME_OVER: return "SEND_GAME_OVER";
+        case EventType::SEND_NPCS: return "SEND_NPCS";
+        case EventType::SEND_MAP_OBJECTS: return "SEND_MAP_OBJECTS";
+        case EventType::OPEN_METRO_UI: return "OPEN_METRO_UI";
+        case EventType::OPEN_TRADE_UI: return "OPEN_TRADE_UI";
+        case EventType::BROADCAST_CHAT_MSG: return "BROADCAST_CHAT_MSG";
+        case EventType::SEND_MESSAGE: return "SEND_MESSAGE";
+        case EventType::SEND_ERROR: return "SEND_ERROR";
+        case EventType::NOTIFICATION: return "NOTIFICATION";
+        case EventType::BROADCAST_PLAYERS: return "BROADCAST_PLAYERS";
+        case EventType::GLOBAL_ANNOUNCEMENT: return "GLOBAL_ANNOUNCEMENT";
+        case EventType::PAY_DEBT: return "PAY_DEBT";
+        case EventType::DIALOG: return "DIALOG";
+        case EventType::MAP_DELTA: return "MAP_DELTA";
+        default: return "UNKNOWN";
+    }
+}
 
 #endif //EVENTTYPE_H
@@ -1,21 +1,75 @@
 #include "GameEvent.h"
+#include <algorithm>
+#include "../utils/FrameArena.h"
+#include "../utils/JsonParser.h"
+#include "../utils/SaxDecoder.h"
 
-GameEvent::GameEvent(const EventType type, const nlohmann::json &payload) {
+GameEvent::GameEvent(const EventType type, nlohmann::json payload, dto::ServerMessage message) {
     this->type = type;
-    this->payload = payload;
+    this->payload = std::move(payload);
+    this->message = std::move(message);
+    this->createdAt = std::chrono::steady_clock::now();
+}
+
+GameEvent::GameEvent(const EventType type, dto::ServerMessage message, const std::string_view frame,
+                     const WireFormat frameFormat) {
+    this->type = type;
+    this->message = std::move(message);
+    this->frameSize = frame.size();
+    this->frameFormat = frameFormat;
+    if (frameFormat == WireFormat::JSON) {
+        std::size_t length = std::min(frame.size(), framePreview.size());
+        // Do not cut a UTF-8 sequence in half.
+        while (length < frame.size() && length > 0 && (static_cast<unsigned char>(frame[length]) & 0xC0) == 0x80) {
+            --length;
+        }
+        std::copy_n(frame.data(), length, framePreview.data());
+        this->framePreviewLength = static_cast<std::uint8_t>(length);
+    }
+    this->createdAt = std::chrono::steady_clock::now();
 }
 
 EventType GameEvent::getType() const {
     return type;
 }
 
-nlohmann::json GameEvent::getPayload() const {
+const nlohmann::json &GameEvent::getPayload() const {
+    return payload;
+}
+
+nlohmann::json &GameEvent::getPayload() {
     return payload;
 }
 
-GameEvent parseEvent(const std::string &message) {
-    nlohmann::json json = nlohmann::json::parse(message);
-    const auto type = json.value("type", "UNKNOWN");
-    const EventType eventType = stringToType.count(type) == 1 ? stringToType[type] : EventType::UNKNOWN;
-    return {eventType, json};
+dto::ServerMessage &GameEvent::getMessage() {
+    return message;
+}
+
+std::size_t GameEvent::getFrameSize() const {
+    return frameSize;
+}
+
+std::string_view GameEvent::getFramePreview() const {
+    return {framePreview.data(), framePreviewLength};
+}
+
+WireFormat GameEvent::getFrameFormat() const {
+    return frameFormat;
+}
+
+std::chrono::steady_clock::time_point GameEvent::getCreatedAt() const {
+    return createdAt;
+}
+
+GameEvent parseEvent(const std::string &message, const WireFormat format) {
+    EventType eventType = EventType::UNKNOWN;
+    dto::ServerMessage decoded;
+    if (!utils::SaxDecoder::decode(message, format, eventType, decoded)) {
+        // The DOM only lives until the DTOs are built; the scope drops all of it at once.
+        utils::FrameArena::Scope arenaScope;
+        const utils::FrameJson json = decodeFrame<utils::FrameJson>(message, format);
+        eventType = eventTypeFromName(json.value("type", "UNKNOWN"));
+        decoded = utils::JsonParser::parseServerMessage(eventType, json);
+    }
+    return {eventType, std::move(decoded), message, format};
 }
@@ -1,9 +1,15 @@
 #ifndef GAMEEVENT_H
 #define GAMEEVENT_H
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "EventType.h"
+#include "../dto/GameResponses.h"
+#include "../network/WireFormat.h"
 #include <nlohmann/json.hpp>
 
 /**
@@ -12,19 +18,54 @@
  * A GameEvent consists of a type (EventType) and a payload (JSON).
  * It is the standard unit of communication between the server and client,
  * and between different components of the client application.
+ *
+ * Events are move-only: a payload can be a multi-kilobyte map DOM, so it is
+ * parsed once and then only moved through the queues, never copied.
+ *
+ * Inbound events carry the payload already decoded into a typed DTO
+ * (dto::ServerMessage) plus what the network log shows of the raw frame: its
+ * size, encoding and first bytes, taken on the network thread so the frame itself
+ * is never copied. Their JSON DOM never leaves the network thread. Outbound events
+ * carry the JSON envelope.
  */
 class GameEvent {
 private:
     EventType type;
     nlohmann::json payload;
+    dto::ServerMessage message;
+    std::size_t frameSize = 0;
+    std::array<char, dto::NetworkLogDto::PreviewLength> framePreview{};
+    std::uint8_t framePreviewLength = 0;
+    WireFormat frameFormat = WireFormat::JSON;
+    std::chrono::steady_clock::time_point createdAt;
 
 public:
     /**
      * @brief Constructs a GameEvent.
      * @param type The type of the event.
-     * @param payload The data associated with the event.
+     * @param payload The data associated with the event, moved into the event.
+     * @param message The decoded payload for inbound events, std::monostate otherwise.
      */
-    GameEvent(EventType type, const nlohmann::json &payload);
+    GameEvent(EventType type, nlohmann::json payload, dto::ServerMessage message = {});
+
+    /**
+     * @brief Constructs an inbound GameEvent from an already decoded message.
+     * @param type The type of the event.
+     * @param message The decoded payload.
+     * @param frame The raw frame as received; only its size and, for text frames, its
+     *        first bytes are kept for the network log.
+     * @param frameFormat The encoding of the raw frame.
+     */
+    GameEvent(EventType type, dto::ServerMessage message, std::string_view frame,
+              WireFormat frameFormat = WireFormat::JSON);
+
+    GameEvent(GameEvent &&) = default;
+
+    GameEvent &operator=(GameEvent &&) = default;
+
+    GameEvent(const GameEvent &) = delete;
+
+    GameEvent &operator=(const GameEvent &) = delete;
 
     /**
      * @brief Gets the type of the event.
@@ -34,17 +75,59 @@ public:
 
     /**
      * @brief Gets the payload of the event.
-     * @return The JSON object containing event data.
+     * @return Reference to the JSON object containing event data, valid as long as the event.
      */
-    [[nodiscard]] nlohmann::json getPayload() const;
+    [[nodiscard]] const nlohmann::json &getPayload() const;
+
+    /**
+     * @brief Gets mutable access to the payload, e.g. to move it out when the event is consumed.
+     * @return Reference to the JSON object containing event data.
+     */
+    [[nodiscard]] nlohmann::json &getPayload();
+
+    /**
+     * @brief Gets the decoded payload; handlers may move the DTOs out of it.
+     * @return Reference to the decoded server message.
+     */
+    [[nodiscard]] dto::ServerMessage &getMessage();
+
+    /**
+     * @brief Gets the size of the raw frame an inbound event was decoded from.
+     * @return Bytes received, 0 for outbound and locally generated events.
+     */
+    [[nodiscard]] std::size_t getFrameSize() const;
+
+    /**
+     * @brief Gets the start of a text frame for the network log.
+     * @return At most dto::NetworkLogDto::PreviewLength bytes, cut on a UTF-8 character
+     *         boundary; empty for binary frames.
+     */
+    [[nodiscard]] std::string_view getFramePreview() const;
+
+    /**
+     * @brief Gets the encoding of the raw frame.
+     * @return WireFormat::JSON unless the frame arrived as a binary message.
+     */
+    [[nodiscard]] WireFormat getFrameFormat() const;
+
+    /**
+     * @brief Gets the moment the event was created.
+     * @return Monotonic timestamp, used to measure how long the event spent queued.
+     */
+    [[nodiscard]] std::chrono::steady_clock::time_point getCreatedAt() const;
 };
 
 /**
- * @brief Parses a raw JSON string into a GameEvent object.
- * @param message The raw JSON string received from the network.
- * @return A constructed GameEvent.
+ * @brief Parses a raw frame into a GameEvent object and decodes its payload.
+ *
+ * Hot message types are decoded by utils::SaxDecoder without building a DOM,
+ * everything else goes through decodeFrame and utils::JsonParser, with the DOM
+ * in the frame arena of the calling thread (utils::FrameArena).
+ * @param message The raw frame received from the network.
+ * @param format The encoding of the frame, JSON text unless negotiated otherwise.
+ * @return A constructed GameEvent with its dto::ServerMessage filled in.
  */
-GameEvent parseEvent(const std::string &message);
+GameEvent parseEvent(const std::string &message, WireFormat format = WireFormat::JSON);
 
 
 #endif //GAMEEVENT_H
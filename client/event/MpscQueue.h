@@ -0,0 +1,107 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief A bounded, lock-free multi-producer/single-consumer ring buffer.
+ *
+ * Every slot carries a sequence number that tells producers and the consumer whose
+ * turn it is (Vyukov's bounded queue). Producers claim a slot with one CAS on the
+ * shared tail and publish it with a release store on the slot; the consumer never
+ * touches the tail. A full queue makes tryEnqueue fail instead of blocking, so
+ * producers on latency-sensitive threads can drop instead of wait.
+ *
+ * @tparam T The type of elements stored in the queue. Must be default-constructible and move-assignable.
+ * @tparam Capacity The number of slots, must be a power of two.
+ */
+template<typename T, std::size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    static constexpr std::size_t CacheLineSize = 64;
+    static constexpr std::size_t Mask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    /** @brief Index of the next slot to claim. Shared by all producers. */
+    alignas(CacheLineSize) std::atomic<std::size_t> _tail{0};
+    /** @brief Index of the next slot to read. Written only by the consumer. */
+    alignas(CacheLineSize) std::atomic<std::size_t> _head{0};
+
+    alignas(CacheLineSize) Cell _cells[Capacity];
+
+public:
+    MpscQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /**
+     * @brief Adds an item without blocking. Safe from any number of threads.
+     * @param item The item to add.
+     * @return True if the item was stored, false if the queue was full.
+     */
+    bool tryEnqueue(T &&item) {
+        std::size_t pos = _tail.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &_cells[pos & Mask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item without blocking. Consumer only.
+     *
+     * An item whose producer has claimed its slot but not finished writing it ends
+     * the read; later items wait for the next call.
+     * @param item Reference where the popped item will be stored.
+     * @return True if an item was popped.
+     */
+    bool tryPop(T &item) {
+        const std::size_t head = _head.load(std::memory_order_relaxed);
+        Cell &cell = _cells[head & Mask];
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+        item = std::move(cell.value);
+        cell.sequence.store(head + Capacity, std::memory_order_release);
+        _head.store(head + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of queued items; exact only when no producer is active.
+     */
+    [[nodiscard]] std::size_t sizeApprox() const {
+        const std::size_t tail = _tail.load(std::memory_order_relaxed);
+        const std::size_t head = _head.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+};
+
+#endif //MPSCQUEUE_H
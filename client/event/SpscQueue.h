@@ -0,0 +1,187 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief A bounded, lock-free single-producer/single-consumer ring buffer.
+ *
+ * Replaces BlockingQueue on the paths where exactly one thread pushes and exactly
+ * one thread pops (network thread -> main loop, main loop -> sender thread).
+ * Push and pop only touch two atomic indices that live on separate cache lines,
+ * so the producer and the consumer never contend on a lock.
+ *
+ * Blocking is opt-in: a consumer that wants to sleep calls wait(), and the producer
+ * only takes the wait mutex when a consumer is actually parked. An optional notifier
+ * callback is invoked after every push so an external event loop can be woken as well.
+ *
+ * @tparam T The type of elements stored in the queue. Only needs to be move-constructible.
+ * @tparam Capacity The number of slots, must be a power of two.
+ */
+template<typename T, std::size_t Capacity = 1024>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    static constexpr std::size_t CacheLineSize = 64;
+    static constexpr std::size_t Mask = Capacity - 1;
+
+    using Slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    /** @brief Index of the next slot to read. Written only by the consumer. */
+    alignas(CacheLineSize) std::atomic<std::size_t> _head{0};
+    /** @brief Consumer-local copy of _tail, refreshed only when the queue looks empty. */
+    std::size_t _cachedTail = 0;
+
+    /** @brief Index of the next slot to write. Written only by the producer. */
+    alignas(CacheLineSize) std::atomic<std::size_t> _tail{0};
+    /** @brief Producer-local copy of _head, refreshed only when the queue looks full. */
+    std::size_t _cachedHead = 0;
+
+    alignas(CacheLineSize) std::atomic<bool> _consumerWaiting{false};
+    bool _wakeRequested = false;
+    std::mutex _waitMutex;
+    std::condition_variable _waitCond;
+    std::function<void()> _notifier;
+
+    alignas(CacheLineSize) Slot _slots[Capacity];
+
+    T *slotAt(const std::size_t index) {
+        return std::launder(reinterpret_cast<T *>(&_slots[index & Mask]));
+    }
+
+    void notifyConsumer() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_consumerWaiting.load(std::memory_order_relaxed)) {
+            std::lock_guard lock(_waitMutex);
+            _waitCond.notify_one();
+        }
+        if (_notifier) {
+            _notifier();
+        }
+    }
+
+public:
+    SpscQueue() = default;
+
+    SpscQueue(const SpscQueue &) = delete;
+
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    ~SpscQueue() {
+        const std::size_t tail = _tail.load(std::memory_order_relaxed);
+        for (std::size_t i = _head.load(std::memory_order_relaxed); i != tail; ++i) {
+            slotAt(i)->~T();
+        }
+    }
+
+    /**
+     * @brief Registers a callback invoked by the producer after every successful push.
+     *
+     * Must be set before the producer thread starts.
+     * @param notifier The callback, typically waking an event loop.
+     */
+    void setNotifier(std::function<void()> notifier) {
+        _notifier = std::move(notifier);
+    }
+
+    /**
+     * @brief Adds an item to the queue without blocking. Producer only.
+     * @param item The item to add.
+     * @return True if the item was stored, false if the queue was full.
+     */
+    bool tryEnqueue(T &&item) {
+        const std::size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cachedHead == Capacity) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail - _cachedHead == Capacity) {
+                return false;
+            }
+        }
+        new(&_slots[tail & Mask]) T(std::move(item));
+        _tail.store(tail + 1, std::memory_order_release);
+        notifyConsumer();
+        return true;
+    }
+
+    /**
+     * @brief Adds an item to the queue. Producer only.
+     *
+     * If the queue is full the producer yields until the consumer frees a slot,
+     * which applies back-pressure instead of dropping events.
+     * @param item The item to add.
+     */
+    void enqueue(T item) {
+        while (!tryEnqueue(std::move(item))) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Tries to remove and return an item from the queue without blocking. Consumer only.
+     * @param item Reference where the popped item will be stored.
+     * @return True if an item was popped, false if the queue was empty.
+     */
+    bool tryPop(T &item) {
+        const std::size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _cachedTail) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head == _cachedTail) {
+                return false;
+            }
+        }
+        T *slot = slotAt(head);
+        item = std::move(*slot);
+        slot->~T();
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Checks whether the queue currently holds no items.
+     * @return True if empty. Exact only when called by the consumer.
+     */
+    [[nodiscard]] bool empty() const {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Blocks the consumer until an item is available, wake() is called or the timeout expires.
+     * @param timeout The maximum time to wait.
+     * @return True if the queue holds at least one item.
+     */
+    template<typename Rep, typename Period>
+    bool wait(const std::chrono::duration<Rep, Period> &timeout) {
+        if (!empty()) {
+            return true;
+        }
+        std::unique_lock lock(_waitMutex);
+        _consumerWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        _waitCond.wait_for(lock, timeout, [this] { return _wakeRequested || !empty(); });
+        _consumerWaiting.store(false, std::memory_order_relaxed);
+        _wakeRequested = false;
+        return !empty();
+    }
+
+    /**
+     * @brief Releases a consumer blocked in wait() even though no item was pushed.
+     *
+     * Used on shutdown so the consumer can observe its stop flag.
+     */
+    void wake() {
+        std::lock_guard lock(_waitMutex);
+        _wakeRequested = true;
+        _waitCond.notify_one();
+    }
+};
+
+
+#endif //SPSCQUEUE_H
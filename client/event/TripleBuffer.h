@@ -0,0 +1,79 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Hands the latest value from one writer thread to one reader thread without locks.
+ *
+ * Three slots rotate between the writer, the reader and a shared middle slot. The
+ * writer fills its slot and publishes it by swapping it with the middle one; the
+ * reader takes the middle slot by swapping it with its own. Both swaps are a single
+ * atomic exchange, neither side ever waits, and a published value is never touched
+ * by the writer again until the reader has let go of it, so the reader sees it as
+ * immutable. Values the reader did not pick up in time are overwritten, which is
+ * what a renderer wants: only the newest state matters.
+ *
+ * Slots are reused, so copy-assigning into the write slot keeps the capacity of its
+ * vectors and maps from earlier rounds.
+ *
+ * @tparam T The value type, must be default-constructible.
+ */
+template<typename T>
+class TripleBuffer {
+    static constexpr std::uint8_t IndexMask = 0x3;
+    static constexpr std::uint8_t FreshBit = 0x4;
+    static constexpr std::size_t CacheLineSize = 64;
+
+    T _slots[3];
+    /** @brief Index of the middle slot, with FreshBit set while it holds an unread value. */
+    alignas(CacheLineSize) std::atomic<std::uint8_t> _middle{1};
+    /** @brief Slot owned by the writer. Touched only by the writer. */
+    alignas(CacheLineSize) std::uint8_t _write = 0;
+    /** @brief Slot owned by the reader. Touched only by the reader. */
+    alignas(CacheLineSize) std::uint8_t _read = 2;
+
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer &) = delete;
+
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    /**
+     * @brief The slot the writer fills before publish(). Writer only.
+     *
+     * Holds an older value, or whatever the reader left in it; overwrite it completely.
+     */
+    T &writeSlot() {
+        return _slots[_write];
+    }
+
+    /**
+     * @brief Makes the write slot the latest value and takes a free slot for the next write. Writer only.
+     */
+    void publish() {
+        _write = _middle.exchange(static_cast<std::uint8_t>(_write | FreshBit), std::memory_order_acq_rel) & IndexMask;
+    }
+
+    /**
+     * @brief Takes the latest published value if there is a newer one. Reader only.
+     * @return True if readSlot() changed.
+     */
+    bool refresh() {
+        if ((_middle.load(std::memory_order_relaxed) & FreshBit) == 0) {
+            return false;
+        }
+        _read = _middle.exchange(_read, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    /**
+     * @brief The value the reader holds, stable until the next refresh(). Reader only.
+     */
+    const T &readSlot() const {
+        return _slots[_read];
+    }
+};
+
+#endif //TRIPLEBUFFER_H
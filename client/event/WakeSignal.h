@@ -0,0 +1,55 @@
+#ifndef WAKESIGNAL_H
+#define WAKESIGNAL_H
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * @brief The single object the main loop blocks on.
+ *
+ * Any number of producers call notify() (the inbound queue notifier, the keyboard
+ * thread); the one waiter sleeps in waitUntil() until a notification arrives or its
+ * deadline passes. Notifications coalesce: however many arrive while the waiter is
+ * busy, the next wait returns immediately once and then blocks again. A notify()
+ * while one is already pending costs a single atomic exchange and no lock.
+ */
+class WakeSignal {
+    std::atomic<bool> _pending{false};
+    std::mutex _mutex;
+    std::condition_variable _cond;
+
+public:
+    WakeSignal() = default;
+
+    WakeSignal(const WakeSignal &) = delete;
+
+    WakeSignal &operator=(const WakeSignal &) = delete;
+
+    /**
+     * @brief Wakes the waiter, or makes its next wait return at once. Safe from any thread.
+     */
+    void notify() {
+        if (_pending.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        std::lock_guard lock(_mutex);
+        _cond.notify_one();
+    }
+
+    /**
+     * @brief Blocks until notify() is called or the deadline passes.
+     * @param deadline The latest time to return.
+     * @return True if woken by a notification, false on timeout.
+     */
+    template<typename Clock, typename Duration>
+    bool waitUntil(const std::chrono::time_point<Clock, Duration> &deadline) {
+        if (!_pending.load(std::memory_order_acquire)) {
+            std::unique_lock lock(_mutex);
+            _cond.wait_until(lock, deadline, [this] { return _pending.load(std::memory_order_acquire); });
+        }
+        return _pending.exchange(false, std::memory_order_acq_rel);
+    }
+};
+
+#endif //WAKESIGNAL_H
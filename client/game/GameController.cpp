@@ -1,252 +1,246 @@
 #include "GameController.h"
 #include "../input/InputHandler.h"
 #include "../dto/GameEventTypes.h"
-#include "../utils/JsonParser.h"
+#include "../network/WireFormat.h"
+#include "../utils/Logger.h"
+#include <algorithm>
 #include <iostream>
-#include <fstream>
 
-using namespace utils;
-
-GameController::GameController(BlockingQueue<GameEvent> *inputQueue, BlockingQueue<GameEvent> *outputQueue) {
+GameController::GameController(SpscQueue<GameEvent> *inputQueue, SpscQueue<GameEvent> *outputQueue,
+                               RenderThread *renderThread, const std::size_t historyDepth) {
     this->inputQueue = inputQueue;
     this->outputQueue = outputQueue;
+    this->renderThread = renderThread;
     this->running = true;
+    this->gameState.setHistoryDepth(historyDepth);
 }
 
-void GameController::update() {
-    if (gameState.exitRequested) {
-        stop();
-        return;
-    }
-
+void GameController::drainEvents() {
     GameEvent event(EventType::UNKNOWN, nullptr);
 
     while (inputQueue->tryPop(event)) {
-        const auto &type = event.getType();
-        const auto &root = event.getPayload();
-
-        if (type == EventType::CONNECTION_ESTABLISHED) {
-            handleConnectionEstablished();
-            continue;
-        }
-
-        if (root.is_null()) {
-            static std::ofstream logger("client_debug.log", std::ios::app);
-            if (logger.is_open()) logger << "[ERROR] Event payload is NULL!" << std::endl;
-            continue;
-        }
-
-        logEvent(type, root);
-
-        if (type == EventType::UNKNOWN) {
-            std::string rawType = JsonParser::safeString(root, "type", "???");
-            std::lock_guard lock(gameState.stateMutex);
-            gameState.connectionStatus = "Unknown Event: " + rawType;
-        }
-
-        if (!root.contains("payload")) {
-            std::string rawType = JsonParser::safeString(root, "type", "???");
-            std::lock_guard lock(gameState.stateMutex);
-            gameState.connectionStatus = "Missing payload for: " + rawType;
-            continue;
-        }
-
-        const auto &data = root["payload"];
-        if (data.is_null()) {
-            continue;
-        }
-
-        dispatchEvent(type, data);
+        (this->*handlers[static_cast<std::size_t>(event.getType())])(event);
     }
 
-    renderer.render(gameState);
+    std::lock_guard lock(gameState.stateMutex);
+    publishSnapshot();
 }
 
-void GameController::logEvent(const EventType& type, const json& root) {
-    static std::ofstream logger("client_debug.log", std::ios::app);
-    if (logger.is_open()) {
-        std::string typeStr = JsonParser::safeString(root, "type", "UNKNOWN_TYPE");
-        logger << "[EVENT] Type: " << typeStr << " | Enum: " << static_cast<int>(type) << std::endl;
-        std::lock_guard lock(gameState.stateMutex);
-        gameState.addNetworkLog("IN", typeStr, root.value("payload", json({})).dump());
+void GameController::publishSnapshot() {
+    if (gameState.getVersion() == publishedVersion) {
+        return;
     }
+    renderThread->publish(gameState);
+    publishedVersion = gameState.getVersion();
 }
 
-void GameController::dispatchEvent(const EventType& type, const json& data) {
-    std::lock_guard lock(gameState.stateMutex);
-
-    switch (type) {
-        case EventType::SEND_STATS: handleSendStats(data); break;
-        case EventType::SEND_INVENTORY: handleSendInventory(data); break;
-        case EventType::SEND_PLAYER_POSITION: handleSendPlayerPosition(data); break;
-        case EventType::SEND_MAP_DATA: handleSendMapData(data); break;
-        case EventType::SEND_LOGIN_OPTIONS: handleSendLoginOptions(data); break;
-        case EventType::SEND_NPCS: handleSendNpcs(data); break;
-        case EventType::SEND_MAP_OBJECTS: handleSendMapObjects(data); break;
-        case EventType::BROADCAST_CHAT_MSG: handleBroadcastChatMsg(data); break;
-        case EventType::OPEN_METRO_UI: handleOpenMetroUi(data); break;
-        case EventType::OPEN_TRADE_UI: handleOpenTradeUi(data); break;
-        case EventType::SEND_GAME_OVER: handleSendGameOver(); break;
-        case EventType::SEND_MESSAGE: handleSendMessage(data, false); break;
-        case EventType::SEND_ERROR: handleSendMessage(data, true); break;
-        case EventType::GLOBAL_ANNOUNCEMENT: handleGlobalAnnouncement(data); break;
-        case EventType::BROADCAST_PLAYERS: handleBroadcastPlayers(data); break;
-        case EventType::DIALOG: handleDialog(data); break;
-        default: break;
+void GameController::logEvent(const GameEvent& event) {
+    const char *typeStr = eventTypeName(event.getType());
+    if (Logger::enabled(LogLevel::DEBUG)) {
+        Logger::log(LogLevel::DEBUG, "EVENT", std::string("Type: ") + typeStr
+                                              + " | Enum: " + std::to_string(static_cast<int>(event.getType())));
     }
+    const char *encoding = event.getFrameFormat() == WireFormat::JSON ? nullptr : wireFormatName(event.getFrameFormat());
+    gameState.addNetworkLog("IN", typeStr, encoding, event.getFrameSize(), event.getFramePreview());
 }
 
-void GameController::handleConnectionEstablished() {
+const std::array<GameController::EventHandler, EventTypeCount> GameController::handlers = [] {
+    std::array<EventHandler, EventTypeCount> table{};
+    // Types without a handler of their own are still logged, and may carry a status.
+    for (auto &handler: table) {
+        handler = &GameController::applyMessage<dto::StatusResponse, &GameController::handleStatus>;
+    }
+    const auto route = [&table](const EventType type, const EventHandler handler) {
+        table[static_cast<std::size_t>(type)] = handler;
+    };
+    route(EventType::CONNECTION_ESTABLISHED, &GameController::handleConnectionEstablished);
+    route(EventType::SEND_STATS,
+          &GameController::applyMessage<dto::StatsUpdateResponse, &GameController::handleSendStats>);
+    route(EventType::SEND_INVENTORY,
+          &GameController::applyMessage<dto::InventoryUpdateResponse, &GameController::handleSendInventory>);
+    route(EventType::SEND_PLAYER_POSITION,
+          &GameController::applyMessage<dto::PlayerPositionResponse, &GameController::handleSendPlayerPosition>);
+    route(EventType::SEND_MAP_DATA,
+          &GameController::applyMessage<dto::MapDataResponse, &GameController::handleSendMapData>);
+    route(EventType::MAP_DELTA,
+          &GameController::applyMessage<dto::MapDeltaResponse, &GameController::handleMapDelta>);
+    route(EventType::SEND_LOGIN_OPTIONS,
+          &GameController::applyMessage<dto::LoginOptionsResponse, &GameController::handleSendLoginOptions>);
+    route(EventType::SEND_NPCS,
+          &GameController::applyMessage<dto::NpcsUpdateResponse, &GameController::handleSendNpcs>);
+    route(EventType::SEND_MAP_OBJECTS,
+          &GameController::applyMessage<dto::MapObjectsUpdateResponse, &GameController::handleSendMapObjects>);
+    route(EventType::BROADCAST_CHAT_MSG,
+          &GameController::applyMessage<dto::ChatMessageResponse, &GameController::handleBroadcastChatMsg>);
+    route(EventType::OPEN_METRO_UI,
+          &GameController::applyMessage<dto::MetroUiResponse, &GameController::handleOpenMetroUi>);
+    route(EventType::OPEN_TRADE_UI,
+          &GameController::applyMessage<dto::TradeUiLoadResponse, &GameController::handleOpenTradeUi>);
+    route(EventType::SEND_GAME_OVER,
+          &GameController::applyMessage<dto::GameOverResponse, &GameController::handleSendGameOver>);
+    route(EventType::SEND_MESSAGE,
+          &GameController::applyMessage<dto::TextMessageResponse, &GameController::handleSendMessage>);
+    route(EventType::SEND_ERROR,
+          &GameController::applyMessage<dto::TextMessageResponse, &GameController::handleSendError>);
+    route(EventType::GLOBAL_ANNOUNCEMENT,
+          &GameController::applyMessage<dto::TextMessageResponse, &GameController::handleGlobalAnnouncement>);
+    route(EventType::BROADCAST_PLAYERS,
+          &GameController::applyMessage<dto::OtherPlayersUpdateResponse, &GameController::handleBroadcastPlayers>);
+    route(EventType::DIALOG,
+          &GameController::applyMessage<dto::DialogResponse, &GameController::handleDialog>);
+    return table;
+}();
+
+template<typename Dto, auto Handle>
+void GameController::applyMessage(GameEvent &event) {
     std::lock_guard lock(gameState.stateMutex);
-    gameState.connectionStatus = "Connected. Sending INIT...";
-    this->outputQueue->enqueue(parseEvent(R"({"type": "INIT", "payload": null})"));
+    logEvent(event);
+    // Handlers change the state through GameState mutators, which bump the version only for
+    // what actually changed; an event that repeats the current state draws nothing.
+    dto::ServerMessage &message = event.getMessage();
+    if (auto *data = std::get_if<Dto>(&message)) {
+        (this->*Handle)(*data);
+    } else if (const auto *status = std::get_if<dto::StatusResponse>(&message)) {
+        handleStatus(*status);
+    }
 }
 
-void GameController::handleSendStats(const json& data) {
-    gameState.player.hp = JsonParser::safeInt(data, "hp", gameState.player.hp);
-    gameState.player.maxHp = JsonParser::safeInt(data, "maxHp", gameState.player.maxHp);
-    gameState.player.rads = JsonParser::safeInt(data, "rads", gameState.player.rads);
-    gameState.player.credits = JsonParser::safeInt(data, "credits", gameState.player.credits);
-    gameState.player.debt = JsonParser::safeInt(data, "debt", gameState.player.debt);
-    gameState.player.globalDebt = JsonParser::safeLong(data, "globalDebt", gameState.player.globalDebt);
-
-    if (data.contains("equippedWeaponSlot")) {
-        if (data["equippedWeaponSlot"].is_null()) gameState.player.equippedWeaponSlot = "";
-        else if (data["equippedWeaponSlot"].is_number()) gameState.player.equippedWeaponSlot = std::to_string(data["equippedWeaponSlot"].get<int>());
-        else if (data["equippedWeaponSlot"].is_string()) gameState.player.equippedWeaponSlot = data["equippedWeaponSlot"].get<std::string>();
-    }
+void GameController::handleStatus(const dto::StatusResponse& data) {
+    gameState.setConnectionStatus(data.status);
+}
 
-    if (data.contains("equippedMaskSlot")) {
-        if (data["equippedMaskSlot"].is_null()) gameState.player.equippedMaskSlot = "";
-        else if (data["equippedMaskSlot"].is_number()) gameState.player.equippedMaskSlot = std::to_string(data["equippedMaskSlot"].get<int>());
-        else if (data["equippedMaskSlot"].is_string()) gameState.player.equippedMaskSlot = data["equippedMaskSlot"].get<std::string>();
+void GameController::handleConnectionEstablished(GameEvent&) {
+    std::lock_guard lock(gameState.stateMutex);
+    gameState.setConnectionStatus("Connected. Sending INIT...");
+    nlohmann::json encodings = nlohmann::json::array();
+    for (const WireFormat format: OfferedWireFormats) {
+        encodings.push_back(wireFormatName(format));
     }
+    nlohmann::json payload;
+    payload["encodings"] = std::move(encodings);
+    this->outputQueue->enqueue(GameEvent(EventType::UNKNOWN, {{"type", ACTION_INIT}, {"payload", std::move(payload)}}));
+}
 
-    gameState.clientState = ClientState::PLAYING;
+void GameController::handleSendStats(const dto::StatsUpdateResponse& data) {
+    gameState.applyStats(data);
+    gameState.setClientState(ClientState::PLAYING);
     gameState.clearError();
 }
 
-void GameController::handleSendInventory(const json& data) {
-    gameState.player.inventory.slots.clear();
-    if (data.is_object()) {
-        for (auto &[key, val]: data.items()) {
-            if (!val.is_null()) {
-                gameState.player.inventory.slots[std::stoi(key)] = JsonParser::parseItem(val);
-            }
-        }
-    }
-    gameState.clientState = ClientState::PLAYING;
+void GameController::handleSendInventory(dto::InventoryUpdateResponse& data) {
+    gameState.setInventory(std::move(data.slots));
+    gameState.setClientState(ClientState::PLAYING);
 }
 
-void GameController::handleSendPlayerPosition(const json& data) {
-    gameState.player.x = JsonParser::safeInt(data, "x", gameState.player.x);
-    gameState.player.y = JsonParser::safeInt(data, "y", gameState.player.y);
-    gameState.player.layerIndex = JsonParser::safeInt(data, "z", gameState.player.layerIndex);
-    gameState.clientState = ClientState::PLAYING;
+void GameController::handleSendPlayerPosition(const dto::PlayerPositionResponse& data) {
+    gameState.applyPlayerPosition(data);
+    gameState.setClientState(ClientState::PLAYING);
 }
 
-void GameController::handleSendMapData(const json& data) {
-    gameState.updateMap(JsonParser::parseMap(data));
-    static std::ofstream logger("client_debug.log", std::ios::app);
-    if (logger.is_open()) {
-        logger << "[MAP] Updated map: " << gameState.map.mapName
-               << " Range: " << gameState.map.rangeX << "x" << gameState.map.rangeY << std::endl;
+void GameController::handleSendMapData(dto::MapDataResponse& data) {
+    gameState.updateMap(std::move(data));
+    if (Logger::enabled(LogLevel::INFO)) {
+        Logger::log(LogLevel::INFO, "MAP", "Updated map: " + gameState.map.mapName + " Range: "
+                                           + std::to_string(gameState.map.rangeX) + "x"
+                                           + std::to_string(gameState.map.rangeY));
     }
     gameState.addGameLog("Mapa načtena: " + gameState.map.mapName);
 }
 
-void GameController::handleSendLoginOptions(const json& data) {
-    gameState.loginOptions = JsonParser::parseLoginOptions(data);
-    gameState.clientState = ClientState::LOGIN_SCREEN;
-    gameState.loginStep = 0;
+void GameController::handleMapDelta(const dto::MapDeltaResponse& data) {
+    if (gameState.applyMapDelta(data) || gameState.mapResyncPending) {
+        return;
+    }
+    gameState.mapResyncPending = true;
+    gameState.addGameLog("Map out of sync, requesting full map.");
+    this->outputQueue->enqueue(GameEvent(EventType::UNKNOWN, {{"type", ACTION_MAP_RESYNC}, {"payload", nullptr}}));
+}
+
+void GameController::handleSendLoginOptions(dto::LoginOptionsResponse& data) {
+    gameState.setLoginOptions(std::move(data));
     gameState.addGameLog("Login options received.");
 }
 
-void GameController::handleSendNpcs(const json& data) {
-    gameState.updateNpcs(JsonParser::parseNpcs(data));
+void GameController::handleSendNpcs(dto::NpcsUpdateResponse& data) {
+    gameState.updateNpcs(std::move(data));
 }
 
-void GameController::handleSendMapObjects(const json& data) {
-    gameState.updateObjects(JsonParser::parseMapObjects(data));
+void GameController::handleSendMapObjects(dto::MapObjectsUpdateResponse& data) {
+    gameState.updateObjects(std::move(data));
 }
 
-void GameController::handleBroadcastChatMsg(const json& data) {
-    gameState.addChatMessage({JsonParser::safeString(data, "message", "")});
-    gameState.addGameLog("CHAT: " + JsonParser::safeString(data, "message", ""));
+void GameController::handleBroadcastChatMsg(const dto::ChatMessageResponse& data) {
+    gameState.addChatMessage(data);
+    gameState.addGameLog("CHAT: " + data.message);
 }
 
-void GameController::handleOpenMetroUi(const json& data) {
-    dto::MetroUiResponse metro;
-    metro.lineId = JsonParser::safeString(data, "lineId", "");
-    if (data.contains("stations") && data["stations"].is_array()) {
-        for (const auto &st: data["stations"]) {
-            if (!st.is_null()) {
-                metro.stations.push_back({JsonParser::safeString(st, "id", ""), JsonParser::safeString(st, "name", "")});
-            }
-        }
-    }
-    gameState.setMetroUi(metro);
+void GameController::handleOpenMetroUi(dto::MetroUiResponse& data) {
+    gameState.setMetroUi(std::move(data));
     gameState.addGameLog("Metro UI opened.");
 }
 
-void GameController::handleOpenTradeUi(const json& data) {
-    dto::TradeUiLoadResponse trade;
-    trade.npcId = JsonParser::safeString(data, "npcId", "");
-    trade.npcName = JsonParser::safeString(data, "npcName", "");
-    if (data.contains("items") && data["items"].is_array()) {
-        for (const auto &item: data["items"]) {
-            if (!item.is_null()) {
-                trade.items.push_back(JsonParser::parseItem(item));
-            }
-        }
-    }
-    gameState.setTradeUi(trade);
+void GameController::handleOpenTradeUi(dto::TradeUiLoadResponse& data) {
+    gameState.setTradeUi(std::move(data));
     gameState.addGameLog("Trade UI opened.");
 }
 
-void GameController::handleSendGameOver() {
+void GameController::handleSendGameOver(const dto::GameOverResponse&) {
     gameState.addGameLog("GAME OVER!");
     gameState.setError("YOU DIED! Restart client to respawn.");
 }
 
-void GameController::handleSendMessage(const json& data, bool isError) {
-    if (data.is_string()) {
-        const std::string msg = data.get<std::string>();
-        gameState.addChatMessage({msg});
-        if (isError) {
-            gameState.setError(msg);
-        }
-    }
+void GameController::handleSendMessage(const dto::TextMessageResponse& data) {
+    gameState.addChatMessage({data.text});
 }
 
-void GameController::handleGlobalAnnouncement(const json& data) {
-    if (data.is_string()) {
-        std::string msg = data.get<std::string>();
-        gameState.addChatMessage({"[GLOBAL] " + msg});
-        gameState.addGameLog("[GLOBAL] " + msg);
-        gameState.showAnnouncement(msg);
-    }
+void GameController::handleSendError(const dto::TextMessageResponse& data) {
+    gameState.addChatMessage({data.text});
+    gameState.setError(data.text);
+}
+
+void GameController::handleGlobalAnnouncement(const dto::TextMessageResponse& data) {
+    gameState.addChatMessage({"[GLOBAL] " + data.text});
+    gameState.addGameLog("[GLOBAL] " + data.text);
+    gameState.showAnnouncement(data.text);
 }
 
-void GameController::handleBroadcastPlayers(const json& data) {
-    gameState.updateOtherPlayers(JsonParser::parseOtherPlayers(data, gameState.player.id));
+void GameController::handleBroadcastPlayers(dto::OtherPlayersUpdateResponse& data) {
+    const std::string &selfId = gameState.player.id;
+    data.erase(std::remove_if(data.begin(), data.end(),
+                              [&selfId](const dto::OtherPlayerDto &p) { return p.id == selfId; }),
+               data.end());
+    gameState.updateOtherPlayers(std::move(data));
 }
 
-void GameController::handleDialog(const json& data) {
-    dto::DialogResponse dialog;
-    dialog.npcName = JsonParser::safeString(data, "npcName", "Unknown");
-    dialog.text = JsonParser::safeString(data, "text", "");
-    gameState.openDialog(dialog);
-    gameState.addGameLog("Dialog started with " + dialog.npcName);
+void GameController::handleDialog(dto::DialogResponse& data) {
+    gameState.addGameLog("Dialog started with " + data.npcName);
+    gameState.openDialog(std::move(data));
 }
 
 void GameController::handleInput(InputHandler &inputHandler) {
     std::lock_guard lock(gameState.stateMutex);
 
-    if (gameState.clientState == ClientState::LOGIN_SCREEN) {
-        inputHandler.processLoginInput(gameState);
-    } else if (gameState.clientState == ClientState::PLAYING) {
-        inputHandler.processGameInput(gameState);
+    // Keys stay queued until the client reaches a state that takes input.
+    while (!gameState.exitRequested) {
+        InputResult result = InputResult::NO_KEY;
+        if (gameState.clientState == ClientState::LOGIN_SCREEN) {
+            result = inputHandler.processLoginInput(gameState);
+        } else if (gameState.clientState == ClientState::PLAYING) {
+            result = inputHandler.processGameInput(gameState);
+        }
+        if (result == InputResult::NO_KEY) {
+            break;
+        }
+        // Input edits fields like inputUsername and loginStep in place; keys that only
+        // send a request leave the frame as it is.
+        if (result == InputResult::CHANGED) {
+            gameState.markDirty();
+        }
+    }
+    publishSnapshot();
+
+    if (gameState.exitRequested) {
+        stop();
     }
 }
 
@@ -257,3 +251,7 @@ bool GameController::isRunning() const {
 void GameController::stop() {
     running = false;
 }
+
+const GameState &GameController::getState() const {
+    return gameState;
+}
@@ -1,12 +1,13 @@
 #ifndef GAMECONTROLLER_H
 #define GAMECONTROLLER_H
 
+#include <array>
+
 #include "../event/GameEvent.h"
 #include "GameState.h"
-#include "../ui/TuiRenderer.h"
-#include <nlohmann/json.hpp>
+#include "../ui/RenderThread.h"
 
-#include "event/BlockingQueue.h"
+#include "event/SpscQueue.h"
 
 class InputHandler;
 
@@ -14,7 +15,7 @@ class InputHandler;
  * @brief Manages the core game logic and state updates.
  *
  * The GameController processes incoming events from the server, updates the
- * GameState accordingly, and triggers the rendering of the UI. It also
+ * GameState accordingly, and hands snapshots of it to the render thread. It also
  * handles user input by delegating to the InputHandler.
  */
 class GameController {
@@ -23,19 +24,25 @@ public:
      * @brief Constructs the GameController.
      * @param inputQueue Queue for events received from the server.
      * @param outputQueue Queue for events to be sent to the server.
+     * @param renderThread Draws the snapshots of the game state this controller publishes.
+     * @param historyDepth Chat, game log and network log lines kept by the game state.
      */
-    GameController(BlockingQueue<GameEvent> *inputQueue, BlockingQueue<GameEvent> *outputQueue);
+    GameController(SpscQueue<GameEvent> *inputQueue, SpscQueue<GameEvent> *outputQueue, RenderThread *renderThread,
+                   std::size_t historyDepth = GameState::DefaultHistoryDepth);
 
     /**
      * @brief Processes pending events from the input queue and updates the game state.
      *
-     * This method should be called in the main loop. It pops events from the queue,
-     * dispatches them to appropriate handlers, and then triggers a re-render.
+     * This method should be called in the main loop whenever the scheduler says the
+     * network is due. It pops events from the queue and dispatches them to the
+     * appropriate handlers.
      */
-    void update();
+    void drainEvents();
 
     /**
-     * @brief Delegates input processing to the InputHandler.
+     * @brief Delegates processing of all queued keys to the InputHandler.
+     *
+     * Stops the controller if the input requested an exit.
      * @param inputHandler The handler responsible for capturing and processing keyboard input.
      */
     void handleInput(InputHandler &inputHandler);
@@ -51,45 +58,75 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Gives read access to the game state, for tools that drive the controller themselves.
+     *
+     * The state mutex must be held while other threads may call into the controller.
+     */
+    [[nodiscard]] const GameState &getState() const;
+
 private:
-    BlockingQueue<GameEvent> *inputQueue;
-    BlockingQueue<GameEvent> *outputQueue;
+    SpscQueue<GameEvent> *inputQueue;
+    SpscQueue<GameEvent> *outputQueue;
     GameState gameState;
-    TuiRenderer renderer;
+    RenderThread *renderThread;
     bool running;
+    /** @brief State version of the last published snapshot. */
+    std::uint64_t publishedVersion = 0;
+
+    /**
+     * @brief Hands a snapshot of the state to the render thread if it changed since the last one.
+     *
+     * The state mutex must be held.
+     */
+    void publishSnapshot();
+
+    /** @brief Applies one inbound event. */
+    using EventHandler = void (GameController::*)(GameEvent &event);
 
-    using json = nlohmann::json;
+    /** @brief The handler of every EventType, indexed by its value. */
+    static const std::array<EventHandler, EventTypeCount> handlers;
 
     /**
-     * @brief Dispatches a game event to the specific handler method based on its type.
-     * @param type The type of the event.
-     * @param payload The JSON payload containing event data.
+     * @brief Logs a server event and applies its already decoded payload with Handle.
+     *
+     * Decoding happened on the network thread, so the state lock, taken once per
+     * event, is only held to log it and move the ready-made DTOs into GameState.
+     * An empty payload is only logged, and a StatusResponse sets the connection
+     * status whatever the type.
+     * @tparam Dto The payload type the decoder produces for the event type.
+     * @tparam Handle Member function applying a Dto; DTOs may be moved out of it.
      */
-    void dispatchEvent(const EventType& type, const json& payload);
+    template<typename Dto, auto Handle>
+    void applyMessage(GameEvent &event);
 
     /**
      * @brief Logs the incoming event to a file and the in-game network log.
-     * @param type The type of the event.
-     * @param payload The JSON payload of the event.
+     *
+     * The caller holds stateMutex.
+     * @param event The inbound event, logged with the size and preview of its raw frame.
      */
-    void logEvent(const EventType& type, const json& payload);
-
-    void handleConnectionEstablished();
-    void handleSendStats(const json& data);
-    void handleSendInventory(const json& data);
-    void handleSendPlayerPosition(const json& data);
-    void handleSendMapData(const json& data);
-    void handleSendLoginOptions(const json& data);
-    void handleSendNpcs(const json& data);
-    void handleSendMapObjects(const json& data);
-    void handleBroadcastChatMsg(const json& data);
-    void handleOpenMetroUi(const json& data);
-    void handleOpenTradeUi(const json& data);
-    void handleSendGameOver();
-    void handleSendMessage(const json& data, bool isError);
-    void handleGlobalAnnouncement(const json& data);
-    void handleBroadcastPlayers(const json& data);
-    void handleDialog(const json& data);
+    void logEvent(const GameEvent& event);
+
+    void handleConnectionEstablished(GameEvent &event);
+    void handleStatus(const dto::StatusResponse& data);
+    void handleSendStats(const dto::StatsUpdateResponse& data);
+    void handleSendInventory(dto::InventoryUpdateResponse& data);
+    void handleSendPlayerPosition(const dto::PlayerPositionResponse& data);
+    void handleSendMapData(dto::MapDataResponse& data);
+    void handleMapDelta(const dto::MapDeltaResponse& data);
+    void handleSendLoginOptions(dto::LoginOptionsResponse& data);
+    void handleSendNpcs(dto::NpcsUpdateResponse& data);
+    void handleSendMapObjects(dto::MapObjectsUpdateResponse& data);
+    void handleBroadcastChatMsg(const dto::ChatMessageResponse& data);
+    void handleOpenMetroUi(dto::MetroUiResponse& data);
+    void handleOpenTradeUi(dto::TradeUiLoadResponse& data);
+    void handleSendGameOver(const dto::GameOverResponse& data);
+    void handleSendMessage(const dto::TextMessageResponse& data);
+    void handleSendError(const dto::TextMessageResponse& data);
+    void handleGlobalAnnouncement(const dto::TextMessageResponse& data);
+    void handleBroadcastPlayers(dto::OtherPlayersUpdateResponse& data);
+    void handleDialog(dto::DialogResponse& data);
 };
 
 #endif //GAMECONTROLLER_H
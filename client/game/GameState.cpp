@@ -1,54 +1,307 @@
 #include "GameState.h"
+#include "../utils/DtoPool.h"
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <tuple>
+
+namespace {
+    /**
+     * @brief Assigns value to field unless they are already equal.
+     * @return True if the field changed.
+     */
+    template<typename T, typename U>
+    bool assignIfChanged(T &field, const U &value) {
+        if (field == value) {
+            return false;
+        }
+        field = value;
+        return true;
+    }
+
+    bool sameNpcs(const dto::NpcsUpdateResponse &a, const dto::NpcsUpdateResponse &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const dto::NpcDto &l, const dto::NpcDto &r) {
+            return std::tie(l.x, l.y, l.z, l.hp, l.maxHp, l.aggressive, l.id, l.name, l.type, l.interaction)
+                   == std::tie(r.x, r.y, r.z, r.hp, r.maxHp, r.aggressive, r.id, r.name, r.type, r.interaction);
+        });
+    }
+
+    bool samePlayers(const dto::OtherPlayersUpdateResponse &a, const dto::OtherPlayersUpdateResponse &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                          [](const dto::OtherPlayerDto &l, const dto::OtherPlayerDto &r) {
+                              return std::tie(l.x, l.y, l.z, l.id, l.name) == std::tie(r.x, r.y, r.z, r.id, r.name);
+                          });
+    }
+
+    bool sameItem(const dto::ItemDto &l, const dto::ItemDto &r) {
+        return std::tie(l.quantity, l.price, l.id, l.name, l.type, l.description, l.rarity)
+               == std::tie(r.quantity, r.price, r.id, r.name, r.type, r.description, r.rarity);
+    }
+
+    bool sameSlots(const std::map<int, dto::ItemDto> &a, const std::map<int, dto::ItemDto> &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto &l, const auto &r) {
+            return l.first == r.first && sameItem(l.second, r.second);
+        });
+    }
+
+    bool sameObjects(const dto::MapObjectsUpdateResponse &a, const dto::MapObjectsUpdateResponse &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const dto::MapObjectDto &l, const dto::MapObjectDto &r) {
+            return std::tie(l.x, l.y, l.z, l.id, l.type, l.action, l.description)
+                   == std::tie(r.x, r.y, r.z, r.id, r.type, r.action, r.description)
+                   && std::equal(l.items.begin(), l.items.end(), r.items.begin(), r.items.end(), sameItem);
+        });
+    }
+
+    bool samePlayer(const dto::PlayerDto &a, const dto::PlayerDto &b) {
+        return std::tie(a.x, a.y, a.layerIndex, a.hp, a.maxHp, a.rads, a.radsLimit, a.credits, a.debt, a.globalDebt,
+                        a.id, a.name, a.equippedWeaponSlot, a.equippedMaskSlot, a.state,
+                        a.inventory.capacity, a.inventory.maxWeight)
+               == std::tie(b.x, b.y, b.layerIndex, b.hp, b.maxHp, b.rads, b.radsLimit, b.credits, b.debt, b.globalDebt,
+                           b.id, b.name, b.equippedWeaponSlot, b.equippedMaskSlot, b.state,
+                           b.inventory.capacity, b.inventory.maxWeight)
+               && sameSlots(a.inventory.slots, b.inventory.slots);
+    }
+
+    bool sameLoginOptions(const dto::LoginOptionsResponse &a, const dto::LoginOptionsResponse &b) {
+        return std::tie(a.classes, a.capabilities, a.encoding) == std::tie(b.classes, b.capabilities, b.encoding)
+               && std::equal(a.maps.begin(), a.maps.end(), b.maps.begin(), b.maps.end(),
+                             [](const dto::MapInfo &l, const dto::MapInfo &r) {
+                                 return std::tie(l.mapId, l.mapName) == std::tie(r.mapId, r.mapName);
+                             });
+    }
+
+    /**
+     * @brief Limits a scroll position so a full window of lines stays visible.
+     */
+    int clampScroll(const int scroll, const std::size_t lines, const int rows) {
+        const std::size_t maxScroll = lines > static_cast<std::size_t>(rows) ? lines - rows : 0;
+        return static_cast<int>(std::clamp<std::size_t>(std::max(0, scroll), 0, maxScroll));
+    }
+
+    /**
+     * @brief Copies the rows lines ending scroll lines before the newest one.
+     */
+    template<typename T>
+    void copyWindow(const RingBuffer<T> &history, const int scroll, const int rows, std::vector<T> &window) {
+        window.clear();
+        const std::size_t end = history.size() - std::min(history.size(), static_cast<std::size_t>(scroll));
+        const std::size_t begin = end > static_cast<std::size_t>(rows) ? end - rows : 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            window.push_back(history[i]);
+        }
+    }
+
+    /**
+     * @brief Moves one layer's tiles by (dx, dy); tiles scrolled in are left blank.
+     */
+    void shiftLayer(TileLayer &layer, const int dx, const int dy) {
+        const int width = layer.width;
+        std::vector<GlyphId> shifted(layer.tiles.size(), GlyphTable::Blank);
+        const int fromX = std::max(0, -dx);
+        const int toX = std::min(width, width - dx);
+        for (int y = 0; y < layer.height && fromX < toX; ++y) {
+            const int oldY = y + dy;
+            if (oldY < 0 || oldY >= layer.height) continue;
+            // Offsets stay indices until they are known to be inside the row; begin() + dx alone
+            // would point before the vector on the top row when shifting left.
+            const std::size_t source = static_cast<std::size_t>(oldY) * width + fromX + dx;
+            const std::size_t target = static_cast<std::size_t>(y) * width + fromX;
+            std::copy_n(layer.tiles.begin() + static_cast<std::ptrdiff_t>(source), toX - fromX,
+                        shifted.begin() + static_cast<std::ptrdiff_t>(target));
+        }
+        layer.tiles = std::move(shifted);
+    }
+}
+
+std::uint64_t GameState::getVersion() const {
+    return version;
+}
+
+void GameState::markDirty() {
+    ++version;
+}
 
 void GameState::updatePlayer(const dto::PlayerDto &playerDto) {
+    if (samePlayer(this->player, playerDto)) {
+        return;
+    }
+    markDirty();
     this->player = playerDto;
 }
 
-void GameState::updateMap(const dto::MapDataResponse &newMap) {
-    this->map = newMap;
+void GameState::applyStats(const dto::StatsUpdateResponse &stats) {
+    bool changed = false;
+    if (stats.hp) changed |= assignIfChanged(player.hp, *stats.hp);
+    if (stats.maxHp) changed |= assignIfChanged(player.maxHp, *stats.maxHp);
+    if (stats.rads) changed |= assignIfChanged(player.rads, *stats.rads);
+    if (stats.credits) changed |= assignIfChanged(player.credits, *stats.credits);
+    if (stats.debt) changed |= assignIfChanged(player.debt, *stats.debt);
+    if (stats.globalDebt) changed |= assignIfChanged(player.globalDebt, *stats.globalDebt);
+    if (stats.equippedWeaponSlot) changed |= assignIfChanged(player.equippedWeaponSlot, *stats.equippedWeaponSlot);
+    if (stats.equippedMaskSlot) changed |= assignIfChanged(player.equippedMaskSlot, *stats.equippedMaskSlot);
+    if (changed) {
+        markDirty();
+    }
 }
 
-void GameState::updateNpcs(const dto::NpcsUpdateResponse &newNpcs) {
-    this->npcs = newNpcs;
+void GameState::applyPlayerPosition(const dto::PlayerPositionResponse &position) {
+    bool changed = false;
+    if (position.x) changed |= assignIfChanged(player.x, *position.x);
+    if (position.y) changed |= assignIfChanged(player.y, *position.y);
+    if (position.z) changed |= assignIfChanged(player.layerIndex, *position.z);
+    if (changed) {
+        markDirty();
+    }
 }
 
-void GameState::updateObjects(const dto::MapObjectsUpdateResponse &newObjects) {
-    this->objects = newObjects;
+void GameState::setInventory(std::map<int, dto::ItemDto> slots) {
+    if (sameSlots(player.inventory.slots, slots)) {
+        return;
+    }
+    markDirty();
+    player.inventory.slots = std::move(slots);
 }
 
-void GameState::updateOtherPlayers(const std::vector<dto::OtherPlayerDto> &players) {
-    this->otherPlayers = players;
+void GameState::setClientState(const ClientState state) {
+    if (assignIfChanged(clientState, state)) {
+        markDirty();
+    }
 }
 
-void GameState::addChatMessage(const dto::ChatMessageResponse &msg) {
-    chatHistory.push_back(msg);
-    if (chatHistory.size() > 10) {
-        chatHistory.erase(chatHistory.begin());
+void GameState::setConnectionStatus(const std::string &status) {
+    if (assignIfChanged(connectionStatus, status)) {
+        markDirty();
     }
 }
 
-void GameState::setMetroUi(const dto::MetroUiResponse &uiData) {
-    this->metroUi = uiData;
+void GameState::setLoginOptions(dto::LoginOptionsResponse options) {
+    if (clientState == ClientState::LOGIN_SCREEN && loginStep == 0 && sameLoginOptions(loginOptions, options)) {
+        return;
+    }
+    markDirty();
+    loginOptions = std::move(options);
+    clientState = ClientState::LOGIN_SCREEN;
+    loginStep = 0;
+}
+
+void GameState::updateMap(dto::MapDataResponse newMap) {
+    markDirty();
+    this->map = std::move(newMap);
+    this->mapResyncPending = false;
+
+    tileLayers.clear();
+    for (const auto &[key, rows]: map.layers) {
+        tileLayers[key] = decodeLayer(glyphs, rows);
+    }
+    // The decoded grid is the only copy kept; the renderer and MAP_DELTA work on it.
+    map.layers.clear();
+}
+
+bool GameState::applyMapDelta(const dto::MapDeltaResponse &delta) {
+    if (tileLayers.empty() || delta.baseX != map.centerX || delta.baseY != map.centerY) {
+        return false;
+    }
+    markDirty();
+
+    const int dx = delta.centerX - delta.baseX;
+    const int dy = delta.centerY - delta.baseY;
+    for (auto &[key, layer]: tileLayers) {
+        if (layer.tiles.empty() || (dx == 0 && dy == 0)) continue;
+
+        shiftLayer(layer, dx, dy);
+        const int top = delta.centerY - (map.rangeY > 0 ? map.rangeY : layer.height / 2);
+        const int left = delta.centerX - (map.rangeX > 0 ? map.rangeX : layer.width / 2);
+        if (const auto it = delta.rows.find(key); it != delta.rows.end()) {
+            for (const auto &strip: it->second) {
+                const int y = strip.index - top;
+                if (y < 0 || y >= layer.height) continue;
+                decodeStrip(glyphs, strip.tiles, &layer.tiles[static_cast<std::size_t>(y) * layer.width], layer.width, 1);
+            }
+        }
+        if (const auto it = delta.columns.find(key); it != delta.columns.end()) {
+            for (const auto &strip: it->second) {
+                const int x = strip.index - left;
+                if (x < 0 || x >= layer.width) continue;
+                decodeStrip(glyphs, strip.tiles, &layer.tiles[x], layer.height, layer.width);
+            }
+        }
+    }
+
+    map.centerX = delta.centerX;
+    map.centerY = delta.centerY;
+
+    for (const auto &tile: delta.tiles) {
+        const auto it = tileLayers.find(std::to_string(tile.z));
+        if (it == tileLayers.end() || it->second.tiles.empty()) continue;
+        auto &layer = it->second;
+        const int y = tile.y - (map.centerY - (map.rangeY > 0 ? map.rangeY : layer.height / 2));
+        const int x = tile.x - (map.centerX - (map.rangeX > 0 ? map.rangeX : layer.width / 2));
+        if (x >= 0 && x < layer.width && y >= 0 && y < layer.height) {
+            layer.tiles[static_cast<std::size_t>(y) * layer.width + x] = glyphs.intern(tile.glyph);
+        }
+    }
+    return true;
+}
+
+void GameState::updateNpcs(dto::NpcsUpdateResponse newNpcs) {
+    if (sameNpcs(this->npcs, newNpcs)) {
+        utils::DtoPool<dto::NpcsUpdateResponse>::give(std::move(newNpcs));
+        return;
+    }
+    markDirty();
+    std::swap(this->npcs, newNpcs);
+    npcIndex.rebuild(this->npcs);
+    utils::DtoPool<dto::NpcsUpdateResponse>::give(std::move(newNpcs));
+}
+
+void GameState::updateObjects(dto::MapObjectsUpdateResponse newObjects) {
+    if (sameObjects(this->objects, newObjects)) {
+        return;
+    }
+    markDirty();
+    this->objects = std::move(newObjects);
+    objectIndex.rebuild(this->objects);
+}
+
+void GameState::updateOtherPlayers(dto::OtherPlayersUpdateResponse players) {
+    if (samePlayers(this->otherPlayers, players)) {
+        utils::DtoPool<dto::OtherPlayersUpdateResponse>::give(std::move(players));
+        return;
+    }
+    markDirty();
+    std::swap(this->otherPlayers, players);
+    otherPlayerIndex.rebuild(this->otherPlayers);
+    utils::DtoPool<dto::OtherPlayersUpdateResponse>::give(std::move(players));
+}
+
+void GameState::addChatMessage(const dto::ChatMessageResponse &msg) {
+    chatHistory.push(msg);
+}
+
+void GameState::setMetroUi(dto::MetroUiResponse uiData) {
+    markDirty();
+    this->metroUi = std::move(uiData);
     this->metroSelectionIndex = 0;
     this->isMetroUiOpen = true;
 }
 
-void GameState::setTradeUi(const dto::TradeUiLoadResponse &uiData) {
-    this->tradeUi = uiData;
+void GameState::setTradeUi(dto::TradeUiLoadResponse uiData) {
+    markDirty();
+    this->tradeUi = std::move(uiData);
     this->tradeSelectionIndex = 0;
     this->isTradeUiOpen = true;
     this->tradeMode = TradeMode::BUY;
 }
 
 void GameState::toggleInventory() {
+    markDirty();
     this->isInventoryOpen = !this->isInventoryOpen;
 }
 
 void GameState::scrollInventory(const int delta) {
     if (player.inventory.slots.empty()) return;
+    markDirty();
     selectedInventoryIndex += delta;
     if (selectedInventoryIndex < 0) selectedInventoryIndex = (int)player.inventory.slots.size() - 1;
     if (selectedInventoryIndex >= player.inventory.slots.size()) selectedInventoryIndex = 0;
@@ -64,6 +317,7 @@ int GameState::getSelectedInventorySlot() const {
 
 void GameState::scrollMetro(int delta) {
     if (metroUi.stations.empty()) return;
+    markDirty();
     metroSelectionIndex = (metroSelectionIndex + delta);
     if (metroSelectionIndex < 0) metroSelectionIndex = (int)metroUi.stations.size() - 1;
     if (metroSelectionIndex >= metroUi.stations.size()) metroSelectionIndex = 0;
@@ -78,12 +332,14 @@ dto::StationDto GameState::getSelectedMetroStation() {
 }
 
 void GameState::closeMetroUi() {
+    markDirty();
     isMetroUiOpen = false;
 }
 
 void GameState::scrollTrade(int delta) {
     if (tradeMode == TradeMode::BUY) {
         if (tradeUi.items.empty()) return;
+        markDirty();
         tradeSelectionIndex = (tradeSelectionIndex + delta);
         if (tradeSelectionIndex < 0) tradeSelectionIndex = (int)tradeUi.items.size() - 1;
         if (tradeSelectionIndex >= tradeUi.items.size()) tradeSelectionIndex = 0;
@@ -101,23 +357,36 @@ dto::ItemDto GameState::getSelectedTradeItem() {
 }
 
 void GameState::closeTradeUi() {
+    markDirty();
     isTradeUiOpen = false;
 }
 
 void GameState::toggleTradeMode() {
+    markDirty();
     if (tradeMode == TradeMode::BUY) tradeMode = TradeMode::SELL;
     else tradeMode = TradeMode::BUY;
 }
 
 void GameState::toggleLogs() {
+    markDirty();
     showLogs = !showLogs;
+    refreshLogWindow();
+}
+
+void GameState::scrollLogs(const int delta) {
+    markDirty();
+    gameLogScroll = clampScroll(gameLogScroll + delta, gameLogHistory.size(), GameLogRows);
+    networkLogScroll = clampScroll(networkLogScroll + delta, networkLogHistory.size(), NetworkLogRows);
+    refreshLogWindow();
 }
 
 void GameState::toggleHelp() {
+    markDirty();
     showHelp = !showHelp;
 }
 
 void GameState::toggleMenu() {
+    markDirty();
     isMenuOpen = !isMenuOpen;
     menuSelectionIndex = 0;
     if (isMenuOpen) {
@@ -130,10 +399,12 @@ void GameState::toggleMenu() {
 }
 
 void GameState::scrollMenu(int delta) {
+    markDirty();
     menuSelectionIndex = (menuSelectionIndex + delta + 3) % 3;
 }
 
 void GameState::togglePayDebt() {
+    markDirty();
     isPayDebtOpen = !isPayDebtOpen;
     debtInput.clear();
     if (isPayDebtOpen) {
@@ -146,6 +417,7 @@ void GameState::togglePayDebt() {
 }
 
 void GameState::showAnnouncement(const std::string& msg) {
+    markDirty();
     announcementMessage = msg;
     isAnnouncementOpen = true;
     isInventoryOpen = false;
@@ -157,12 +429,14 @@ void GameState::showAnnouncement(const std::string& msg) {
 }
 
 void GameState::closeAnnouncement() {
+    markDirty();
     isAnnouncementOpen = false;
     announcementMessage.clear();
 }
 
-void GameState::openDialog(const dto::DialogResponse& dialog) {
-    currentDialog = dialog;
+void GameState::openDialog(dto::DialogResponse dialog) {
+    markDirty();
+    currentDialog = std::move(dialog);
     isDialogOpen = true;
     isInventoryOpen = false;
     isMetroUiOpen = false;
@@ -173,40 +447,77 @@ void GameState::openDialog(const dto::DialogResponse& dialog) {
 }
 
 void GameState::closeDialog() {
+    markDirty();
     isDialogOpen = false;
     currentDialog = {};
 }
 
 void GameState::addGameLog(const std::string &msg) {
+    markDirty();
     const auto now = std::chrono::system_clock::now();
     const auto time = std::chrono::system_clock::to_time_t(now);
     std::stringstream ss;
     ss << "[" << std::put_time(std::localtime(&time), "%H:%M:%S") << "] " << msg;
-    gameLogs.push_back(ss.str());
-    if (gameLogs.size() > 8) {
-        gameLogs.erase(gameLogs.begin());
+    gameLogHistory.push(ss.str());
+    if (gameLogScroll > 0) {
+        // Keep showing the same lines while the player reads back.
+        gameLogScroll = clampScroll(gameLogScroll + 1, gameLogHistory.size(), GameLogRows);
     }
+    refreshLogWindow();
 }
 
-void GameState::addNetworkLog(const std::string &dir, const std::string &type, const std::string &payload) {
-    const auto now = std::chrono::system_clock::now();
-    const auto time = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time), "%H:%M:%S");
-    
-    std::string p_short = payload;
-    if (p_short.length() > 60) p_short = p_short.substr(0, 60) + "...";
+void GameState::addNetworkLog(const char *dir, const char *type, const char *encoding, const std::size_t size,
+                              const std::string_view preview) {
+    // Nothing on screen changes while the panel is hidden; toggleLogs redraws with the
+    // entries buffered meanwhile.
+    if (showLogs) {
+        markDirty();
+    }
+    dto::NetworkLogDto entry;
+    entry.timestamp = std::chrono::system_clock::now();
+    entry.direction = dir;
+    entry.type = type;
+    entry.encoding = encoding;
+    entry.size = size;
+    const std::size_t length = std::min(preview.size(), dto::NetworkLogDto::PreviewLength);
+    std::copy_n(preview.data(), length, entry.preview.data());
+    entry.previewLength = static_cast<std::uint8_t>(length);
+    networkLogHistory.push(entry);
+    if (networkLogScroll > 0) {
+        networkLogScroll = clampScroll(networkLogScroll + 1, networkLogHistory.size(), NetworkLogRows);
+    }
+    refreshLogWindow();
+}
+
+void GameState::setHistoryDepth(const std::size_t depth) {
+    markDirty();
+    chatHistory.setCapacity(depth);
+    gameLogHistory.setCapacity(depth);
+    networkLogHistory.setCapacity(depth);
+    gameLogScroll = clampScroll(gameLogScroll, gameLogHistory.size(), GameLogRows);
+    networkLogScroll = clampScroll(networkLogScroll, networkLogHistory.size(), NetworkLogRows);
+    refreshLogWindow();
+}
 
-    networkLogs.push_back({ss.str(), dir, type, p_short});
-    if (networkLogs.size() > 8) {
-        networkLogs.erase(networkLogs.begin());
+void GameState::refreshLogWindow() {
+    gameLogCount = gameLogHistory.size();
+    networkLogCount = networkLogHistory.size();
+    if (!showLogs) {
+        gameLogs.clear();
+        networkLogs.clear();
+        return;
     }
+    copyWindow(gameLogHistory, gameLogScroll, GameLogRows, gameLogs);
+    copyWindow(networkLogHistory, networkLogScroll, NetworkLogRows, networkLogs);
 }
 
 void GameState::setError(const std::string &err) {
+    markDirty();
     lastError = err;
 }
 
 void GameState::clearError() {
+    if (lastError.empty()) return;
+    markDirty();
     lastError.clear();
 }
@@ -1,9 +1,14 @@
 #ifndef GAMESTATE_H
 #define GAMESTATE_H
 
+#include <cstdint>
 #include <vector>
 #include <mutex>
+#include <string_view>
 #include "../dto/GameResponses.h"
+#include "SpatialIndex.h"
+#include "TileGrid.h"
+#include "../utils/RingBuffer.h"
 #include <nlohmann/json.hpp>
 
 /**
@@ -24,17 +29,13 @@ enum class TradeMode {
 };
 
 /**
- * @brief Holds the entire state of the game client.
+ * @brief The part of the game state the renderer draws.
  *
- * This class acts as a central repository for all game data, including player stats,
- * map data, UI state, logs, and other entities. It is thread-safe for concurrent access
- * (though primarily accessed by the main thread).
+ * Plain copyable data. GameState extends it with the mutators and bookkeeping, and
+ * the controller copies it into a RenderSnapshot so frames are built without holding
+ * the state mutex.
  */
-class GameState {
-public:
-    /** @brief Mutex to protect concurrent access to the game state. */
-    mutable std::mutex stateMutex;
-
+struct GameView {
     ClientState clientState = ClientState::WAITING_FOR_INIT;
     dto::LoginOptionsResponse loginOptions;
     std::string inputUsername;
@@ -45,15 +46,36 @@ public:
     dto::PlayerDto player;
     std::vector<dto::OtherPlayerDto> otherPlayers;
 
+    /** @brief The current map; its layers are moved into tileLayers when it arrives. */
     dto::MapDataResponse map;
+    /** @brief Glyphs used by tileLayers. */
+    GlyphTable glyphs;
+    /** @brief Map layers decoded into glyph ids, keyed like MapDataResponse::layers. */
+    std::map<std::string, TileLayer> tileLayers;
     dto::NpcsUpdateResponse npcs;
     dto::MapObjectsUpdateResponse objects;
+    /**
+     * @brief npcs, objects and otherPlayers indexed by layer and position for the map viewport.
+     *
+     * Rebuilt by updateNpcs, updateObjects and updateOtherPlayers; change the vectors
+     * through those so the index does not go stale.
+     */
+    SpatialIndex npcIndex;
+    SpatialIndex objectIndex;
+    SpatialIndex otherPlayerIndex;
 
     std::string connectionStatus = "Connecting to server...";
+    /** @brief The game log lines the log panel shows, oldest first. Empty while the panel is hidden. */
     std::vector<std::string> gameLogs;
+    /** @brief The network log entries the log panel shows, oldest first. Empty while the panel is hidden. */
     std::vector<dto::NetworkLogDto> networkLogs;
+    /** @brief How many lines the game log panel is scrolled back from the newest one; 0 follows new lines. */
+    int gameLogScroll = 0;
+    int networkLogScroll = 0;
+    /** @brief Lines kept in each history, for the scroll position in the panel title. */
+    std::size_t gameLogCount = 0;
+    std::size_t networkLogCount = 0;
     std::string lastError;
-    std::vector<dto::ChatMessageResponse> chatHistory;
 
     dto::MetroUiResponse metroUi;
     dto::TradeUiLoadResponse tradeUi;
@@ -68,7 +90,6 @@ public:
     bool showHelp = false;
     bool isMenuOpen = false;
     int menuSelectionIndex = 0;
-    bool exitRequested = false;
 
     bool isPayDebtOpen = false;
     std::string debtInput;
@@ -78,16 +99,100 @@ public:
 
     bool isDialogOpen = false;
     dto::DialogResponse currentDialog;
+};
+
+/**
+ * @brief A copy of the GameView taken by the controller, tagged with the state version it was taken at.
+ */
+struct RenderSnapshot {
+    std::uint64_t version = 0;
+    /** @brief Position in publish order; gaps are snapshots the renderer never drew. */
+    std::uint64_t sequence = 0;
+    GameView view;
+};
+
+/**
+ * @brief Holds the entire state of the game client.
+ *
+ * This class acts as a central repository for all game data, including player stats,
+ * map data, UI state, logs, and other entities. It is thread-safe for concurrent access
+ * (though primarily accessed by the main thread).
+ */
+class GameState : public GameView {
+public:
+    /** @brief Default number of chat, game log and network log lines kept. */
+    static constexpr std::size_t DefaultHistoryDepth = 10000;
+    /** @brief Rows of game log and of network log in the log panel. */
+    static constexpr int GameLogRows = 4;
+    static constexpr int NetworkLogRows = 5;
+
+    /** @brief Mutex to protect concurrent access to the game state. */
+    mutable std::mutex stateMutex;
+
+    /** @brief A MAP_RESYNC request is in flight; further mismatching deltas are dropped quietly. */
+    bool mapResyncPending = false;
+    RingBuffer<dto::ChatMessageResponse> chatHistory{DefaultHistoryDepth};
+    bool exitRequested = false;
+
+    /**
+     * @brief Returns the version of the state, bumped by every change that can show on screen.
+     *
+     * The renderer compares it with the version it drew last and skips the frame when
+     * nothing changed.
+     */
+    [[nodiscard]] std::uint64_t getVersion() const;
 
+    /**
+     * @brief Bumps the version; called by every mutator below and by code that writes the
+     * public fields directly.
+     */
+    void markDirty();
+
+    /** @brief Replaces the player; a player equal to the current one leaves the version alone. */
     void updatePlayer(const dto::PlayerDto &playerDto);
-    void updateMap(const dto::MapDataResponse &newMap);
-    void updateNpcs(const dto::NpcsUpdateResponse &newNpcs);
-    void updateObjects(const dto::MapObjectsUpdateResponse &newObjects);
-    void updateOtherPlayers(const std::vector<dto::OtherPlayerDto> &players);
+
+    /** @brief Applies the fields a STATS_UPDATE carries; the version only moves if one of them changed. */
+    void applyStats(const dto::StatsUpdateResponse &stats);
+
+    /** @brief Applies the coordinates a position update carries; the version only moves if the player moved. */
+    void applyPlayerPosition(const dto::PlayerPositionResponse &position);
+    /** @brief Replaces the inventory slots; the version only moves if an item changed. */
+    void setInventory(std::map<int, dto::ItemDto> slots);
+    void setClientState(ClientState state);
+    void setConnectionStatus(const std::string &status);
+
+    /**
+     * @brief Stores the login choices and restarts the login screen at its first step.
+     *
+     * Repeating the current choices while that step is already shown changes nothing.
+     */
+    void setLoginOptions(dto::LoginOptionsResponse options);
+    void updateMap(dto::MapDataResponse newMap);
+
+    /**
+     * @brief Applies a MAP_DELTA to the decoded layers in place.
+     *
+     * Tiles still inside the moved viewport are kept, the revealed strips from the
+     * delta fill the rest, and the changed tiles are patched last.
+     * @param delta The decoded delta.
+     * @return False if the delta was built for another viewport; the map is left untouched.
+     */
+    bool applyMapDelta(const dto::MapDeltaResponse &delta);
+    /**
+     * @brief Replaces the NPCs; the previous list goes to utils::DtoPool for the decoder to refill.
+     *
+     * A list equal to the current one goes to the pool instead and leaves the version alone.
+     */
+    void updateNpcs(dto::NpcsUpdateResponse newNpcs);
+    /** @brief Replaces the map objects; a list equal to the current one leaves the version alone. */
+    void updateObjects(dto::MapObjectsUpdateResponse newObjects);
+    /** @brief Replaces the other players like updateNpcs, skipping lists equal to the current one. */
+    void updateOtherPlayers(dto::OtherPlayersUpdateResponse players);
+    /** @brief Keeps a chat message in the history; the history is not drawn, so the version stays. */
     void addChatMessage(const dto::ChatMessageResponse &msg);
 
-    void setMetroUi(const dto::MetroUiResponse &uiData);
-    void setTradeUi(const dto::TradeUiLoadResponse &uiData);
+    void setMetroUi(dto::MetroUiResponse uiData);
+    void setTradeUi(dto::TradeUiLoadResponse uiData);
 
     void toggleInventory();
     void scrollInventory(int delta);
@@ -103,6 +208,12 @@ public:
     void toggleTradeMode();
 
     void toggleLogs();
+
+    /**
+     * @brief Scrolls both halves of the log panel.
+     * @param delta Lines to move; positive goes back in history. Clamped to the history.
+     */
+    void scrollLogs(int delta);
     void toggleHelp();
     void toggleMenu();
     void scrollMenu(int delta);
@@ -111,13 +222,41 @@ public:
     void showAnnouncement(const std::string& msg);
     void closeAnnouncement();
 
-    void openDialog(const dto::DialogResponse& dialog);
+    void openDialog(dto::DialogResponse dialog);
     void closeDialog();
 
     void addGameLog(const std::string& msg);
-    void addNetworkLog(const std::string& dir, const std::string& type, const std::string& payload);
+    /**
+     * @brief Records a frame in the network log without formatting it.
+     * @param dir "IN" or "OUT"; must outlive the log, as must type and encoding.
+     * @param type The event type name.
+     * @param encoding Protocol name of a binary frame, null for a JSON text frame.
+     * @param size Bytes in the frame.
+     * @param preview Start of a text frame as GameEvent keeps it, empty for binary frames;
+     *        anything past dto::NetworkLogDto::PreviewLength is ignored.
+     */
+    void addNetworkLog(const char *dir, const char *type, const char *encoding, std::size_t size,
+                       std::string_view preview);
+
+    /**
+     * @brief Sets how many chat, game log and network log lines are kept; the newest ones survive.
+     */
+    void setHistoryDepth(std::size_t depth);
     void setError(const std::string& err);
     void clearError();
+
+private:
+    std::uint64_t version = 1;
+    RingBuffer<std::string> gameLogHistory{DefaultHistoryDepth};
+    RingBuffer<dto::NetworkLogDto> networkLogHistory{DefaultHistoryDepth};
+
+    /**
+     * @brief Copies the visible part of the log histories into the view.
+     *
+     * Snapshots copy the view, so only the lines on screen are copied, however deep
+     * the history is.
+     */
+    void refreshLogWindow();
 };
 
 #endif //GAMESTATE_H
@@ -0,0 +1,71 @@
+#include "SpatialIndex.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPATIALINDEX_SSE2
+#endif
+
+namespace {
+    /**
+     * @brief Appends indices[i] for every i in [begin, end) whose position lies in the rectangle.
+     */
+    void clip(const std::int32_t *xs, const std::int32_t *ys, const std::uint32_t *indices, std::size_t begin,
+              const std::size_t end, const int minX, const int minY, const int maxX, const int maxY,
+              std::vector<std::uint32_t> &out) {
+#if defined(__AVX2__)
+        const __m256i lowX = _mm256_set1_epi32(minX);
+        const __m256i highX = _mm256_set1_epi32(maxX);
+        const __m256i lowY = _mm256_set1_epi32(minY);
+        const __m256i highY = _mm256_set1_epi32(maxY);
+        for (; begin + 8 <= end; begin += 8) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xs + begin));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ys + begin));
+            const __m256i outside = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpgt_epi32(lowX, x), _mm256_cmpgt_epi32(x, highX)),
+                _mm256_or_si256(_mm256_cmpgt_epi32(lowY, y), _mm256_cmpgt_epi32(y, highY)));
+            const int mask = ~_mm256_movemask_ps(_mm256_castsi256_ps(outside));
+            for (int lane = 0; lane < 8; ++lane) {
+                if (mask & (1 << lane)) out.push_back(indices[begin + lane]);
+            }
+        }
+#elif defined(SPATIALINDEX_SSE2)
+        const __m128i lowX = _mm_set1_epi32(minX);
+        const __m128i highX = _mm_set1_epi32(maxX);
+        const __m128i lowY = _mm_set1_epi32(minY);
+        const __m128i highY = _mm_set1_epi32(maxY);
+        for (; begin + 4 <= end; begin += 4) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(xs + begin));
+            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ys + begin));
+            const __m128i outside = _mm_or_si128(
+                _mm_or_si128(_mm_cmplt_epi32(x, lowX), _mm_cmpgt_epi32(x, highX)),
+                _mm_or_si128(_mm_cmplt_epi32(y, lowY), _mm_cmpgt_epi32(y, highY)));
+            const int mask = ~_mm_movemask_ps(_mm_castsi128_ps(outside));
+            for (int lane = 0; lane < 4; ++lane) {
+                if (mask & (1 << lane)) out.push_back(indices[begin + lane]);
+            }
+        }
+#endif
+        for (; begin < end; ++begin) {
+            if (xs[begin] >= minX && xs[begin] <= maxX && ys[begin] >= minY && ys[begin] <= maxY) {
+                out.push_back(indices[begin]);
+            }
+        }
+    }
+}
+
+void SpatialIndex::query(const int z, const int minX, const int minY, const int maxX, const int maxY,
+                         std::vector<std::uint32_t> &out) const {
+    if (keys.empty() || maxX < minX || maxY < minY) {
+        return;
+    }
+    const int firstColumn = minX >> BlockShift;
+    const int lastColumn = maxX >> BlockShift;
+    for (int row = minY >> BlockShift; row <= maxY >> BlockShift; ++row) {
+        const auto first = std::lower_bound(keys.begin(), keys.end(), blockKey(z, firstColumn, row));
+        const auto last = std::upper_bound(first, keys.end(), blockKey(z, lastColumn, row));
+        clip(xs.data(), ys.data(), indices.data(), first - keys.begin(), last - keys.begin(),
+             minX, minY, maxX, maxY, out);
+    }
+}
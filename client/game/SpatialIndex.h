@@ -0,0 +1,90 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+/**
+ * @brief Groups entities by layer and by square block of tiles so a viewport only visits its own blocks.
+ *
+ * Entities are sorted by block: layer, then block row, then block column. A query
+ * does one binary search per block row it covers and clips the positions of that
+ * row's run of blocks to the rectangle. Entities of one block keep their order in
+ * the source vector, so when several stand on the same tile the later one still
+ * wins, as when drawing the whole vector.
+ *
+ * Positions are kept as separate x and y arrays next to the block keys, and the
+ * DTOs with their strings stay in the source vector, so clipping reads only packed
+ * ints and is vectorised with SSE2, or AVX2 when the build enables it. Everything
+ * is plain vectors, so copying a GameView into a snapshot stays cheap.
+ */
+class SpatialIndex {
+public:
+    /** @brief Blocks are (1 << BlockShift) tiles on a side. */
+    static constexpr int BlockShift = 4;
+
+    /**
+     * @brief Replaces the index with one for the given entities.
+     * @param entities Anything with int x, y and z members; indices refer to it until the next rebuild.
+     */
+    template<typename Entities>
+    void rebuild(const Entities &entities) {
+        const std::size_t count = entities.size();
+        std::vector<std::uint64_t> unsortedKeys(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto &entity = entities[i];
+            unsortedKeys[i] = blockKey(entity.z, entity.x >> BlockShift, entity.y >> BlockShift);
+        }
+        std::vector<std::uint32_t> order(count);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](const std::uint32_t a, const std::uint32_t b) {
+            return unsortedKeys[a] < unsortedKeys[b];
+        });
+
+        keys.resize(count);
+        xs.resize(count);
+        ys.resize(count);
+        indices = std::move(order);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto &entity = entities[indices[i]];
+            keys[i] = unsortedKeys[indices[i]];
+            xs[i] = entity.x;
+            ys[i] = entity.y;
+        }
+    }
+
+    /**
+     * @brief Appends the index of every entity on layer z inside the rectangle.
+     *
+     * Indices come block by block, and in source order within a block.
+     * @param minX Left tile column, inclusive; likewise for the other bounds.
+     * @param out Receives the indices; not cleared first.
+     */
+    void query(int z, int minX, int minY, int maxX, int maxY, std::vector<std::uint32_t> &out) const;
+
+    [[nodiscard]] std::size_t size() const {
+        return indices.size();
+    }
+
+private:
+    std::vector<std::uint64_t> keys;
+    std::vector<std::int32_t> xs;
+    std::vector<std::int32_t> ys;
+    /** @brief Position of each entry in the source vector. */
+    std::vector<std::uint32_t> indices;
+
+    /** @brief Packs layer, block row and block column so the keys sort row by row within a layer. */
+    static std::uint64_t blockKey(const int z, const int column, const int row) {
+        constexpr std::uint32_t Bias24 = 1u << 23;
+        constexpr std::uint32_t Bias16 = 1u << 15;
+        const auto field24 = [](const int value) {
+            return static_cast<std::uint64_t>((static_cast<std::uint32_t>(value) + Bias24) & 0xFFFFFF);
+        };
+        const auto layer = static_cast<std::uint64_t>((static_cast<std::uint32_t>(z) + Bias16) & 0xFFFF);
+        return layer << 48 | field24(row) << 24 | field24(column);
+    }
+};
+
+#endif //SPATIALINDEX_H
@@ -0,0 +1,76 @@
+#include "TickScheduler.h"
+#include <algorithm>
+
+namespace {
+    /** @brief How often an idle client checks whether the terminal was resized. */
+    constexpr auto ResizePollInterval = std::chrono::milliseconds(250);
+
+    TickScheduler::Clock::duration intervalOf(const int hz) {
+        if (hz <= 0) {
+            return TickScheduler::Clock::duration::zero();
+        }
+        return std::chrono::duration_cast<TickScheduler::Clock::duration>(std::chrono::seconds(1)) / hz;
+    }
+
+    uint64_t micros(const TickScheduler::Clock::duration d) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+    }
+}
+
+TickScheduler::TickScheduler(const ScheduleConfig &config) {
+    this->networkInterval = intervalOf(config.networkHz);
+    this->frameInterval = intervalOf(config.renderFps);
+    this->stats.budgetMicros = micros(frameInterval);
+}
+
+bool TickScheduler::networkDue(const Clock::time_point now) {
+    if (now >= nextNetworkAt) {
+        return true;
+    }
+    networkPending = true;
+    return false;
+}
+
+void TickScheduler::networkDrained(const Clock::time_point now) {
+    networkPending = false;
+    nextNetworkAt = now + networkInterval;
+}
+
+bool TickScheduler::frameDue(const Clock::time_point now) {
+    if (now >= nextFrameAt) {
+        return true;
+    }
+    framePending = true;
+    return false;
+}
+
+void TickScheduler::frameDone(const Clock::time_point start, const Clock::time_point end, const bool drawn) {
+    framePending = false;
+    if (!drawn) {
+        return;
+    }
+    nextFrameAt = start + frameInterval;
+
+    const uint64_t took = micros(end - start);
+    ++stats.framesDrawn;
+    stats.renderMicros += took;
+    stats.maxRenderMicros = std::max(stats.maxRenderMicros, took);
+    if (frameInterval > Clock::duration::zero() && end - start > frameInterval) {
+        ++stats.framesOverBudget;
+    }
+}
+
+TickScheduler::Clock::time_point TickScheduler::nextWake(const Clock::time_point now) const {
+    Clock::time_point wake = now + ResizePollInterval;
+    if (framePending) {
+        wake = std::min(wake, nextFrameAt);
+    }
+    if (networkPending) {
+        wake = std::min(wake, nextNetworkAt);
+    }
+    return wake;
+}
+
+FrameBudgetStats TickScheduler::getStats() const {
+    return stats;
+}
@@ -0,0 +1,89 @@
+#ifndef TICKSCHEDULER_H
+#define TICKSCHEDULER_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Rates of the main loop's independent tasks, set from the command line.
+ */
+struct ScheduleConfig {
+    /** @brief Keyboard poll rate in Hz; bounds input latency where the console cannot signal input. */
+    int inputHz = 1000;
+    /** @brief Network drain rate in Hz; 0 drains as soon as events arrive. */
+    int networkHz = 0;
+    /** @brief Upper bound on drawn frames per second. */
+    int renderFps = 60;
+};
+
+/**
+ * @brief Frame-budget counters of the render task. Durations are in microseconds.
+ */
+struct FrameBudgetStats {
+    uint64_t framesDrawn = 0;
+    uint64_t framesOverBudget = 0; ///< Frames that took longer than one frame interval to draw.
+    uint64_t renderMicros = 0;    ///< Sum of the time spent drawing frames.
+    uint64_t maxRenderMicros = 0;
+    uint64_t budgetMicros = 0;    ///< The frame interval.
+};
+
+/**
+ * @brief Decides when the main loop drains the network and when the render thread draws a frame.
+ *
+ * Each loop owns its own instance and uses its half. Input is not scheduled here:
+ * keys are handled on every wake-up of the main loop, so a low frame rate delays
+ * drawing but never input. Network drains are immediate unless a rate
+ * is configured. Frames are drawn at most once per frame interval; a change that
+ * arrives inside the interval is drawn at its end.
+ */
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TickScheduler(const ScheduleConfig &config);
+
+    /**
+     * @brief Checks whether the network queue should be drained now.
+     * @param now The current time.
+     */
+    bool networkDue(Clock::time_point now);
+
+    /**
+     * @brief Records a network drain that started at the given time.
+     */
+    void networkDrained(Clock::time_point now);
+
+    /**
+     * @brief Checks whether a frame may be drawn now; if not, the next wake-up is moved to the frame deadline.
+     * @param now The current time.
+     */
+    bool frameDue(Clock::time_point now);
+
+    /**
+     * @brief Records one render call for the frame budget.
+     * @param start When the render call started.
+     * @param end When it returned.
+     * @param drawn False if the renderer skipped the frame because nothing changed; such
+     * calls do not count against the budget.
+     */
+    void frameDone(Clock::time_point start, Clock::time_point end, bool drawn);
+
+    /**
+     * @brief Returns the latest time the loop should wake up even without events or keys.
+     * @param now The current time.
+     */
+    [[nodiscard]] Clock::time_point nextWake(Clock::time_point now) const;
+
+    [[nodiscard]] FrameBudgetStats getStats() const;
+
+private:
+    Clock::duration networkInterval;
+    Clock::duration frameInterval;
+    Clock::time_point nextNetworkAt;
+    Clock::time_point nextFrameAt;
+    bool networkPending = false;
+    bool framePending = false;
+    FrameBudgetStats stats;
+};
+
+#endif //TICKSCHEDULER_H
@@ -0,0 +1,70 @@
+#include "TileGrid.h"
+#include "../utils/Utf8.h"
+#include <algorithm>
+
+GlyphTable::GlyphTable() {
+    asciiIds.fill(Unset);
+    intern(" ");
+    intern("?");
+}
+
+GlyphId GlyphTable::internSlow(const char *data, const std::size_t length, const std::uint32_t key) {
+    const auto lead = static_cast<unsigned char>(data[0]);
+    CacheEntry &entry = recent[(key ^ key >> 8) % recent.size()];
+    if (const auto it = ids.find(key); it != ids.end()) {
+        entry = {key, it->second};
+        return it->second;
+    }
+    if (glyphs.size() >= ReservedBase) {
+        return intern("?");
+    }
+
+    const auto id = static_cast<GlyphId>(glyphs.size());
+    glyphs.emplace_back(data, std::min<std::size_t>(length, 4));
+    ids.emplace(key, id);
+    entry = {key, id};
+    if (length == 1 && lead < asciiIds.size()) {
+        asciiIds[lead] = id;
+    }
+    return id;
+}
+
+GlyphId GlyphTable::intern(const std::string &glyph) {
+    return glyph.empty() ? Blank : intern(glyph.data(), utils::Utf8::glyphLength(glyph, 0));
+}
+
+const std::string &GlyphTable::glyph(const GlyphId id) const {
+    return id < glyphs.size() ? glyphs[id] : glyphs[Blank];
+}
+
+std::size_t GlyphTable::size() const {
+    return glyphs.size();
+}
+
+TileLayer decodeLayer(GlyphTable &glyphs, const std::vector<std::string> &rows) {
+    TileLayer layer;
+    layer.height = static_cast<int>(rows.size());
+    for (const auto &row: rows) {
+        layer.width = std::max(layer.width, static_cast<int>(utils::Utf8::glyphCount(row)));
+    }
+    layer.tiles.assign(static_cast<std::size_t>(layer.width) * layer.height, GlyphTable::Blank);
+    for (int y = 0; y < layer.height; ++y) {
+        decodeStrip(glyphs, rows[y], &layer.tiles[static_cast<std::size_t>(y) * layer.width], layer.width, 1);
+    }
+    return layer;
+}
+
+void decodeStrip(GlyphTable &glyphs, const std::string &strip, GlyphId *out, const int count, const int stride) {
+    std::size_t pos = 0;
+    for (int i = 0; i < count; ++i) {
+        GlyphId id = GlyphTable::Blank;
+        if (pos < strip.size()) {
+            const std::size_t length = static_cast<unsigned char>(strip[pos]) < 0x80
+                                           ? 1
+                                           : utils::Utf8::glyphLength(strip, pos);
+            id = glyphs.intern(strip.data() + pos, length);
+            pos += length;
+        }
+        out[static_cast<std::size_t>(i) * stride] = id;
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef TILEGRID_H
+#define TILEGRID_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** @brief Compact id of a map glyph, an index into the GlyphTable. */
+using GlyphId = std::uint16_t;
+
+/**
+ * @brief Interns the glyphs used on the map so tiles can be stored as small ids.
+ *
+ * Id 0 is always the blank " ", which the renderer treats as transparent. The table
+ * only grows; a map uses a few dozen distinct glyphs. A glyph is one code point, at
+ * most four UTF-8 bytes, so lookups key on the bytes packed into an integer; ASCII
+ * glyphs skip the hash map entirely.
+ */
+class GlyphTable {
+public:
+    static constexpr GlyphId Blank = 0;
+    /** @brief Ids from here up are reserved for the renderer's overlay symbols. */
+    static constexpr GlyphId ReservedBase = 0xFF00;
+
+    GlyphTable();
+
+    /**
+     * @brief Returns the id of a glyph, adding it to the table if it is new.
+     * @param data Pointer to the UTF-8 bytes of one glyph.
+     * @param length Number of bytes, 1 to 4.
+     * @return The id; the id of "?" once the table is full.
+     */
+    GlyphId intern(const char *data, const std::size_t length) {
+        const auto lead = static_cast<unsigned char>(data[0]);
+        if (length == 1 && lead < asciiIds.size() && asciiIds[lead] != Unset) {
+            return asciiIds[lead];
+        }
+        std::uint32_t key = 0;
+        for (std::size_t i = 0; i < length && i < 4; ++i) {
+            key = key << 8 | static_cast<unsigned char>(data[i]);
+        }
+        const CacheEntry &entry = recent[(key ^ key >> 8) % recent.size()];
+        if (entry.key == key && key != 0) {
+            return entry.id;
+        }
+        return internSlow(data, length, key);
+    }
+
+    /**
+     * @brief Interns the first glyph of a string; an empty string is the blank.
+     */
+    GlyphId intern(const std::string &glyph);
+
+    /**
+     * @brief Returns the UTF-8 text of a glyph id.
+     */
+    [[nodiscard]] const std::string &glyph(GlyphId id) const;
+
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    static constexpr GlyphId Unset = 0xFFFF;
+
+    struct CacheEntry {
+        std::uint32_t key = 0;
+        GlyphId id = Blank;
+    };
+
+    std::vector<std::string> glyphs;
+    std::unordered_map<std::uint32_t, GlyphId> ids;
+    std::array<GlyphId, 128> asciiIds{};
+    /** @brief Direct-mapped cache in front of `ids` for the multi-byte box-drawing glyphs. */
+    std::array<CacheEntry, 64> recent{};
+
+    GlyphId internSlow(const char *data, std::size_t length, std::uint32_t key);
+};
+
+/**
+ * @brief One map layer decoded into glyph ids, row-major, width * height entries.
+ */
+struct TileLayer {
+    int width = 0;
+    int height = 0;
+    std::vector<GlyphId> tiles;
+
+    [[nodiscard]] GlyphId at(const int x, const int y) const {
+        return tiles[static_cast<std::size_t>(y) * width + x];
+    }
+};
+
+/**
+ * @brief Decodes a layer's UTF-8 rows into a TileLayer.
+ *
+ * The width is the longest row; shorter rows are padded with blanks.
+ * @param glyphs The table new glyphs are added to.
+ * @param rows The rows as received in MapDataResponse::layers.
+ * @return The decoded layer.
+ */
+TileLayer decodeLayer(GlyphTable &glyphs, const std::vector<std::string> &rows);
+
+/**
+ * @brief Decodes a UTF-8 strip of glyphs into ids written every `stride` entries.
+ *
+ * Used with stride 1 for rows and stride width for columns. Writes exactly `count`
+ * ids; missing glyphs become blanks, extra glyphs are ignored.
+ * @param glyphs The table new glyphs are added to.
+ * @param strip The UTF-8 glyphs.
+ * @param out Where the first id goes.
+ * @param count Number of ids to write.
+ * @param stride Distance between consecutive ids in `out`.
+ */
+void decodeStrip(GlyphTable &glyphs, const std::string &strip, GlyphId *out, int count, int stride);
+
+#endif //TILEGRID_H
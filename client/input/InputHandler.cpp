@@ -1,22 +1,26 @@
 #include "InputHandler.h"
 #include "../game/GameController.h"
-#include <conio.h>
+#include "../utils/DtoCodec.h"
+#include <algorithm>
 #include <iostream>
 
-using json = nlohmann::json;
-
 namespace KeyCodes {
     constexpr int Up = 72;
     constexpr int Down = 80;
     constexpr int Left = 75;
     constexpr int Right = 77;
+    constexpr int Home = 71;
+    constexpr int End = 79;
+    constexpr int PageUp = 73;
+    constexpr int PageDown = 81;
     constexpr int Enter = 13;
     constexpr int Backspace = 8;
     constexpr int ExtendedOffset = 1000;
     constexpr int Escape = 27;
 }
 
-InputHandler::InputHandler(BlockingQueue<GameEvent> *outQueue) : outputQueue(outQueue), gameController(nullptr) {
+InputHandler::InputHandler(SpscQueue<GameEvent> *outQueue, KeyQueue *keyQueue)
+    : outputQueue(outQueue), keyQueue(keyQueue), gameController(nullptr) {
     setupBindings();
 }
 
@@ -27,115 +31,89 @@ void InputHandler::setGameController(GameController* controller) {
 void InputHandler::setupBindings() {
     using namespace KeyCodes;
 
-    keyBindings[Up + ExtendedOffset] = [this]() {
-        outputQueue->enqueue(parseEvent(R"({"type": "MOVE", "payload": {"direction": "UP"}})"));
-    };
-    keyBindings[Down + ExtendedOffset] = [this]() {
-        outputQueue->enqueue(parseEvent(R"({"type": "MOVE", "payload": {"direction": "DOWN"}})"));
-    };
-    keyBindings[Left + ExtendedOffset] = [this]() {
-        outputQueue->enqueue(parseEvent(R"({"type": "MOVE", "payload": {"direction": "LEFT"}})"));
-    };
-    keyBindings[Right + ExtendedOffset] = [this]() {
-        outputQueue->enqueue(parseEvent(R"({"type": "MOVE", "payload": {"direction": "RIGHT"}})"));
+    const auto bindMove = [this](const int key, const char *direction) {
+        keyBindings[key + ExtendedOffset] = [this, direction]() {
+            dto::MoveRequest request;
+            request.direction = direction;
+            outputQueue->enqueue(GameEvent(EventType::PLAYER_MOVED, utils::DtoCodec::encodeRequest(request)));
+        };
     };
+    bindMove(Up, "UP");
+    bindMove(Down, "DOWN");
+    bindMove(Left, "LEFT");
+    bindMove(Right, "RIGHT");
 
     keyBindings[' '] = [this]() {
-        outputQueue->enqueue(parseEvent(R"({"type": "ATTACK", "payload": {}})"));
+        outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(dto::AttackRequest{})));
+    };
+    keyBindings['e'] = [this]() {
+        outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(dto::InteractRequest{})));
     };
-    keyBindings['e'] = [this]() { outputQueue->enqueue(parseEvent(R"({"type": "INTERACT", "payload": {}})")); };
     keyBindings['u'] = [this]() {
-        outputQueue->enqueue(parseEvent(R"({"type": "USE", "payload": {"slotIndex": 0}})"));
+        dto::UseRequest request;
+        request.slotIndex = 0;
+        outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(request)));
     };
 }
 
-GameEvent InputHandler::parseEvent(const std::string& jsonStr) {
-    auto j = json::parse(jsonStr);
-    const std::string typeStr = j.value("type", "UNKNOWN");
-    auto type = EventType::UNKNOWN;
-
-    if (typeStr == "MOVE") type = EventType::PLAYER_MOVED;
-    else if (typeStr == "ATTACK") type = EventType::UNKNOWN;
-    else if (typeStr == "INTERACT") type = EventType::UNKNOWN;
-
-    return {type, j};
-}
-
-void InputHandler::processGameInput(GameState &state) {
-    if (_kbhit()) {
-        int key = _getch();
-        bool isExtended = false;
-        if (key == 0 || key == 224) {
-            key = _getch();
-            isExtended = true;
-        }
+InputResult InputHandler::processGameInput(GameState &state) {
+    if (KeyPress press; keyQueue->tryPop(press)) {
+        const int key = press.key;
+        const bool isExtended = press.extended;
 
+        bool changed;
         if (state.isAnnouncementOpen) {
-            handleAnnouncementInput(state, key);
-            return;
-        }
-
-        if (state.isDialogOpen) {
-            handleDialogInput(state, key);
-            return;
-        }
-
-        if (state.showHelp) {
-            handleHelpInput(state, key, isExtended);
-            return;
-        }
-
-        if (state.isMenuOpen) {
-            handleMenuInput(state, key, isExtended);
-            return;
-        }
-
-        if (state.isPayDebtOpen) {
-            handlePayDebtInput(state, key);
-            return;
-        }
-
-        if (state.isMetroUiOpen) {
-            handleMetroInput(state, key, isExtended);
-            return;
-        }
-
-        if (state.isTradeUiOpen) {
-            handleTradeInput(state, key, isExtended);
-            return;
-        }
-
-        if (state.isInventoryOpen) {
-            handleInventoryInput(state, key, isExtended);
-            return;
+            changed = handleAnnouncementInput(state, key);
+        } else if (state.isDialogOpen) {
+            changed = handleDialogInput(state, key);
+        } else if (state.showHelp) {
+            changed = handleHelpInput(state, key, isExtended);
+        } else if (state.isMenuOpen) {
+            changed = handleMenuInput(state, key, isExtended);
+        } else if (state.isPayDebtOpen) {
+            changed = handlePayDebtInput(state, key);
+        } else if (state.isMetroUiOpen) {
+            changed = handleMetroInput(state, key, isExtended);
+        } else if (state.isTradeUiOpen) {
+            changed = handleTradeInput(state, key, isExtended);
+        } else if (state.isInventoryOpen) {
+            changed = handleInventoryInput(state, key, isExtended);
+        } else {
+            changed = handleStandardGameInput(state, key, isExtended);
         }
-
-        handleStandardGameInput(state, key, isExtended);
+        return changed ? InputResult::CHANGED : InputResult::UNCHANGED;
     }
+    return InputResult::NO_KEY;
 }
 
-void InputHandler::handleAnnouncementInput(GameState &state, int key) {
+bool InputHandler::handleAnnouncementInput(GameState &state, int key) {
     if (key == KeyCodes::Enter || key == KeyCodes::Escape) {
         state.closeAnnouncement();
+        return true;
     }
+    return false;
 }
 
-void InputHandler::handleDialogInput(GameState &state, int key) {
+bool InputHandler::handleDialogInput(GameState &state, int key) {
     if (key == KeyCodes::Enter || key == KeyCodes::Escape) {
         state.closeDialog();
+        return true;
     }
+    return false;
 }
 
-void InputHandler::handleHelpInput(GameState &state, int key, bool isExtended) {
+bool InputHandler::handleHelpInput(GameState &state, int key, bool isExtended) {
     if (key == KeyCodes::Escape || (!isExtended && (key == 'h' || key == 'H'))) {
         state.toggleHelp();
+        return true;
     }
+    return false;
 }
 
-void InputHandler::handleMenuInput(GameState &state, int key, bool isExtended) {
+bool InputHandler::handleMenuInput(GameState &state, int key, bool isExtended) {
     if (key == KeyCodes::Escape) {
         state.toggleMenu();
-        return;
+        return true;
     }
     if (isExtended && key == KeyCodes::Up) {
         state.scrollMenu(-1);
@@ -148,39 +126,48 @@ void InputHandler::handleMenuInput(GameState &state, int key, bool isExtended) {
             case 0: state.toggleMenu(); break;
             case 1: state.toggleHelp(); break;
             case 2: state.exitRequested = true; break;
-            default: ;
+            default: return false;
         }
+    } else {
+        return false;
     }
+    return true;
 }
 
-void InputHandler::handlePayDebtInput(GameState &state, int key) {
+bool InputHandler::handlePayDebtInput(GameState &state, int key) {
     if (key == KeyCodes::Escape) {
         state.togglePayDebt();
-        return;
+        return true;
     }
     if (key == KeyCodes::Enter) {
-        if (!state.debtInput.empty()) {
-            try {
-                int amount = std::stoi(state.debtInput);
-                json payload;
-                payload["amount"] = amount;
-                json req;
-                req["type"] = "PAY_DEBT";
-                req["payload"] = payload;
-                outputQueue->enqueue(parseEvent(req.dump()));
-                state.togglePayDebt();
-            } catch (...) {
-                state.setError("Invalid amount");
-            }
+        if (state.debtInput.empty()) {
+            return false;
+        }
+        try {
+            dto::PayDebtRequest request;
+            request.amount = std::stoi(state.debtInput);
+            outputQueue->enqueue(GameEvent(EventType::PAY_DEBT, utils::DtoCodec::encodeRequest(request)));
+            state.togglePayDebt();
+        } catch (...) {
+            state.setError("Invalid amount");
         }
-    } else if (key == KeyCodes::Backspace) {
-        if (!state.debtInput.empty()) state.debtInput.pop_back();
-    } else if (isdigit(key)) {
+        return true;
+    }
+    if (key == KeyCodes::Backspace) {
+        if (state.debtInput.empty()) {
+            return false;
+        }
+        state.debtInput.pop_back();
+        return true;
+    }
+    if (isdigit(key)) {
         state.debtInput += static_cast<char>(key);
+        return true;
     }
+    return false;
 }
 
-void InputHandler::handleMetroInput(GameState &state, int key, bool isExtended) {
+bool InputHandler::handleMetroInput(GameState &state, int key, bool isExtended) {
     if (isExtended && key == KeyCodes::Up) {
         state.scrollMetro(-1);
     }
@@ -189,22 +176,23 @@ void InputHandler::handleMetroInput(GameState &state, int key, bool isExtended)
     }
     else if (key == KeyCodes::Enter) {
         auto[id, name] = state.getSelectedMetroStation();
-        if (!id.empty()) {
-            json payload;
-            payload["mapId"] = id;
-            payload["lineId"] = state.metroUi.lineId;
-            json req;
-            req["type"] = "TRAVEL";
-            req["payload"] = payload;
-            outputQueue->enqueue(parseEvent(req.dump()));
-            state.closeMetroUi();
+        if (id.empty()) {
+            return false;
         }
+        dto::TravelRequest request;
+        request.mapId = id;
+        request.lineId = state.metroUi.lineId;
+        outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(request)));
+        state.closeMetroUi();
     } else if (key == KeyCodes::Escape) {
         state.closeMetroUi();
+    } else {
+        return false;
     }
+    return true;
 }
 
-void InputHandler::handleTradeInput(GameState &state, int key, bool isExtended) {
+bool InputHandler::handleTradeInput(GameState &state, int key, bool isExtended) {
     if (isExtended && key == KeyCodes::Up) {
         state.scrollTrade(-1);
     }
@@ -212,155 +200,177 @@ void InputHandler::handleTradeInput(GameState &state, int key, bool isExtended)
         state.scrollTrade(1);
     }
     else if (key == KeyCodes::Enter) {
+        // Buying and selling only send a request; the server answers with the new state.
         if (state.tradeMode == TradeMode::BUY) {
             auto item = state.getSelectedTradeItem();
             if (!item.id.empty()) {
-                json payload;
-                payload["npcId"] = state.tradeUi.npcId;
-                payload["itemIndex"] = state.tradeSelectionIndex;
-                json req;
-                req["type"] = "BUY";
-                req["payload"] = payload;
-                outputQueue->enqueue(parseEvent(req.dump()));
+                dto::BuyRequest request;
+                request.npcId = state.tradeUi.npcId;
+                request.itemIndex = state.tradeSelectionIndex;
+                outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(request)));
             }
         } else {
             int slot = state.getSelectedInventorySlot();
             if (slot != -1) {
-                json payload;
-                payload["npcId"] = state.tradeUi.npcId;
-                payload["slotIndex"] = slot;
-                json req;
-                req["type"] = "SELL";
-                req["payload"] = payload;
-                outputQueue->enqueue(parseEvent(req.dump()));
+                dto::SellRequest request;
+                request.npcId = state.tradeUi.npcId;
+                request.slotIndex = slot;
+                outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(request)));
             }
         }
+        return false;
     } else if (!isExtended && (key == 's' || key == 'S')) {
         state.toggleTradeMode();
     } else if (key == KeyCodes::Escape) {
         state.closeTradeUi();
+    } else {
+        return false;
     }
+    return true;
 }
 
-void InputHandler::handleInventoryInput(GameState &state, int key, bool isExtended) {
+bool InputHandler::handleInventoryInput(GameState &state, int key, bool isExtended) {
     if ((!isExtended && (key == 'i' || key == 'I')) || key == KeyCodes::Escape) {
         state.toggleInventory();
-        return;
+        return true;
     }
     if (isExtended && key == KeyCodes::Up) {
         state.scrollInventory(-1);
+        return true;
     }
-    else if (isExtended && key == KeyCodes::Down) {
+    if (isExtended && key == KeyCodes::Down) {
         state.scrollInventory(1);
+        return true;
     }
-    else if (!isExtended && (key == 'e' || key == 'E')) {
+    // Equipping, using and dropping only send a request.
+    if (!isExtended && (key == 'e' || key == 'E')) {
         if (const int slot = state.getSelectedInventorySlot();
             slot != -1) {
-            outputQueue->enqueue(parseEvent(R"({"type": "EQUIP", "payload": {"slotIndex": )" + std::to_string(slot) + "}}"));
+            dto::EquipRequest request;
+            request.slotIndex = slot;
+            outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(request)));
         }
     } else if (!isExtended && (key == 'u' || key == 'U')) {
         if (const int slot = state.getSelectedInventorySlot();
             slot != -1) {
-            outputQueue->enqueue(parseEvent(R"({"type": "USE", "payload": {"slotIndex": )" + std::to_string(slot) + "}}"));
+            dto::UseRequest request;
+            request.slotIndex = slot;
+            outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(request)));
         }
     } else if (!isExtended && (key == 'd' || key == 'D')) {
         if (const int slot = state.getSelectedInventorySlot();
             slot != -1) {
-            outputQueue->enqueue(parseEvent(R"({"type": "DROP", "payload": {"slotIndex": )" + std::to_string(slot) + R"(, "amount": 1}})"));
+            dto::DropRequest request;
+            request.slotIndex = slot;
+            request.amount = 1;
+            outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(request)));
         }
     }
+    return false;
 }
 
-void InputHandler::handleStandardGameInput(GameState &state, int key, bool isExtended) {
+bool InputHandler::handleStandardGameInput(GameState &state, int key, bool isExtended) {
     const int bindingKey = isExtended ? key + KeyCodes::ExtendedOffset : key;
 
     if (key == KeyCodes::Escape) {
         state.toggleMenu();
-        return;
+        return true;
     }
 
     if (!isExtended && (key == 'i' || key == 'I')) {
         state.toggleInventory();
-        return;
+        return true;
     }
 
     if (!isExtended && (key == 'l' || key == 'L')) {
         state.toggleLogs();
-        return;
+        return true;
     }
 
     if (!isExtended && (key == 'h' || key == 'H')) {
         state.toggleHelp();
-        return;
+        return true;
+    }
+
+    if (state.showLogs && isExtended) {
+        const int history = static_cast<int>(std::max(state.gameLogCount, state.networkLogCount));
+        switch (key) {
+            case KeyCodes::PageUp: state.scrollLogs(GameState::NetworkLogRows); return true;
+            case KeyCodes::PageDown: state.scrollLogs(-GameState::NetworkLogRows); return true;
+            case KeyCodes::Home: state.scrollLogs(history); return true;
+            case KeyCodes::End: state.scrollLogs(-history); return true;
+            default: break;
+        }
     }
 
     if (!isExtended && (key == 'p' || key == 'P')) {
         state.togglePayDebt();
-        return;
+        return true;
     }
 
+    // Bound keys (moving, attacking, interacting) only send a request.
     if (keyBindings.count(bindingKey)) {
         keyBindings[bindingKey]();
     } else if (!isExtended && keyBindings.count(tolower(key))) {
         keyBindings[tolower(key)]();
     }
+    return false;
 }
 
-void InputHandler::processLoginInput(GameState &state) {
-    if (_kbhit()) {
-        int key = _getch();
-        bool isExtended = false;
-
-        if (key == 0 || key == 224) {
-            key = _getch();
-            isExtended = true;
-        }
+InputResult InputHandler::processLoginInput(GameState &state) {
+    if (KeyPress press; keyQueue->tryPop(press)) {
+        const int key = press.key;
+        const bool isExtended = press.extended;
+        bool changed = false;
 
         if (state.loginStep == 1) {
             if (isExtended && key == KeyCodes::Up && state.selectedClassIndex > 0) {
                 state.selectedClassIndex--;
+                changed = true;
             }
             if (isExtended && key == KeyCodes::Down && state.selectedClassIndex < state.loginOptions.classes.size() - 1) {
                 state.selectedClassIndex++;
+                changed = true;
             }
         } else if (state.loginStep == 2) {
             if (isExtended && key == KeyCodes::Up && state.selectedMapIndex > 0) {
                 state.selectedMapIndex--;
+                changed = true;
             }
             if (isExtended && key == KeyCodes::Down && state.selectedMapIndex < state.loginOptions.maps.size() - 1) {
                 state.selectedMapIndex++;
+                changed = true;
             }
         }
 
         if (key == KeyCodes::Backspace) {
             if (state.loginStep == 0 && !state.inputUsername.empty()) {
                 state.inputUsername.pop_back();
+                changed = true;
             }
-            return;
-        }
-
-        if (key == KeyCodes::Enter) {
-            if (state.loginStep == 0 && !state.inputUsername.empty()) state.loginStep++;
-            else if (state.loginStep == 1 && !state.loginOptions.classes.empty()) state.loginStep++;
-            else if (state.loginStep == 2 && !state.loginOptions.maps.empty()) {
-                json payload;
-                payload["username"] = state.inputUsername;
-                payload["playerClass"] = state.loginOptions.classes[state.selectedClassIndex];
-                payload["startingMapId"] = state.loginOptions.maps[state.selectedMapIndex].mapId;
-
-                json req;
-                req["type"] = "LOGIN";
-                req["payload"] = payload;
-
-                outputQueue->enqueue(parseEvent(req.dump()));
+        } else if (key == KeyCodes::Enter) {
+            if (state.loginStep == 0 && !state.inputUsername.empty()) {
+                state.loginStep++;
+                changed = true;
+            } else if (state.loginStep == 1 && !state.loginOptions.classes.empty()) {
+                state.loginStep++;
+                changed = true;
+            } else if (state.loginStep == 2 && !state.loginOptions.maps.empty()) {
+                dto::LoginRequest request;
+                request.username = state.inputUsername;
+                request.playerClass = state.loginOptions.classes[state.selectedClassIndex];
+                request.startingMapId = state.loginOptions.maps[state.selectedMapIndex].mapId;
+                outputQueue->enqueue(GameEvent(EventType::UNKNOWN, utils::DtoCodec::encodeRequest(request)));
                 state.loginStep = 3;
+                changed = true;
             }
-            return;
-        }
-        if (state.loginStep == 0) {
+        } else if (state.loginStep == 0) {
             if (!isExtended && (isalnum(key) || key == '_' || key == '-')) {
                 state.inputUsername += static_cast<char>(key);
+                changed = true;
             }
         }
+        return changed ? InputResult::CHANGED : InputResult::UNCHANGED;
     }
+    return InputResult::NO_KEY;
 }
@@ -1,56 +1,61 @@
 #ifndef INPUTHANDLER_H
 #define INPUTHANDLER_H
 
-#include "../event/BlockingQueue.h"
+#include "../event/SpscQueue.h"
 #include "../event/GameEvent.h"
 #include "../game/GameState.h"
+#include "KeyboardReader.h"
 #include <nlohmann/json.hpp>
 
 class GameController;
 
+/**
+ * @brief What processing one key did.
+ */
+enum class InputResult {
+    NO_KEY, ///< The key queue was empty.
+    UNCHANGED, ///< A key was read; it only sent a request or did nothing.
+    CHANGED ///< A key was read and changed state the client draws.
+};
+
 /**
  * @brief Handles user input from the keyboard.
  *
- * This class captures keyboard events, interprets them based on the current
- * game state (e.g., menu, inventory, game world), and sends corresponding
- * GameEvents to the output queue.
+ * This class takes the keys read by the KeyboardReader, interprets them based on
+ * the current game state (e.g., menu, inventory, game world), and sends
+ * corresponding GameEvents to the output queue.
  */
 class InputHandler {
 private:
-    BlockingQueue<GameEvent> *outputQueue;
+    SpscQueue<GameEvent> *outputQueue;
+    KeyQueue *keyQueue;
     std::map<int, std::function<void()> > keyBindings;
     GameController* gameController;
 
-    using json = nlohmann::json;
-
     /**
      * @brief Initializes default key bindings for standard game actions.
      */
     void setupBindings();
 
-    /**
-     * @brief Helper to create a GameEvent from a JSON string.
-     * @param jsonStr The JSON payload string.
-     * @return A constructed GameEvent.
-     */
-    GameEvent parseEvent(const std::string& jsonStr);
-
-    void handleAnnouncementInput(GameState &state, int key);
-    void handleDialogInput(GameState &state, int key);
-    void handleHelpInput(GameState &state, int key, bool isExtended);
-    void handleMenuInput(GameState &state, int key, bool isExtended);
-    void handlePayDebtInput(GameState &state, int key);
-    void handleMetroInput(GameState &state, int key, bool isExtended);
-    void handleTradeInput(GameState &state, int key, bool isExtended);
-    void handleInventoryInput(GameState &state, int key, bool isExtended);
-    void handleStandardGameInput(GameState &state, int key, bool isExtended);
+    // Each handler returns true if the key changed local state, false if it only sent
+    // a request or did nothing.
+    bool handleAnnouncementInput(GameState &state, int key);
+    bool handleDialogInput(GameState &state, int key);
+    bool handleHelpInput(GameState &state, int key, bool isExtended);
+    bool handleMenuInput(GameState &state, int key, bool isExtended);
+    bool handlePayDebtInput(GameState &state, int key);
+    bool handleMetroInput(GameState &state, int key, bool isExtended);
+    bool handleTradeInput(GameState &state, int key, bool isExtended);
+    bool handleInventoryInput(GameState &state, int key, bool isExtended);
+    bool handleStandardGameInput(GameState &state, int key, bool isExtended);
 
 public:
     /**
      * @brief Constructs the InputHandler.
      * @param outQueue The queue where generated GameEvents will be pushed.
+     * @param keyQueue The queue the KeyboardReader pushes keys to.
      */
-    explicit InputHandler(BlockingQueue<GameEvent> *outQueue);
+    InputHandler(SpscQueue<GameEvent> *outQueue, KeyQueue *keyQueue);
 
     /**
      * @brief Sets the reference to the GameController.
@@ -61,14 +66,16 @@ public:
     /**
      * @brief Processes input when the client is in the PLAYING state.
      * @param state The current game state.
+     * @return Whether a key was taken from the key queue and whether it changed the state.
      */
-    void processGameInput(GameState &state);
+    InputResult processGameInput(GameState &state);
 
     /**
      * @brief Processes input when the client is in the LOGIN_SCREEN state.
      * @param state The current game state.
+     * @return Whether a key was taken from the key queue and whether it changed the state.
      */
-    void processLoginInput(GameState &state);
+    InputResult processLoginInput(GameState &state);
 };
 
 #endif //INPUTHANDLER_H
@@ -0,0 +1,85 @@
+#include "KeyboardReader.h"
+#include <conio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace {
+    /** @brief Longest single wait on the console handle, bounds how long stop() takes. */
+    constexpr unsigned long InputWaitMillis = 100;
+
+    /**
+     * @brief Sleeps until the console has input or, where it cannot signal input, for one poll interval.
+     */
+    void waitForConsoleInput(const std::chrono::microseconds pollInterval) {
+#ifdef _WIN32
+        // The handle wakes the thread on input, so the poll interval plays no part here.
+        // Signalled for any console input record, including focus and mouse events,
+        // so the caller still checks _kbhit() afterwards and discards the rest.
+        (void) pollInterval;
+        WaitForSingleObject(GetStdHandle(STD_INPUT_HANDLE), InputWaitMillis);
+#else
+        std::this_thread::sleep_for(pollInterval);
+#endif
+    }
+
+    /**
+     * @brief Drops the pending console records that are not keys _getch() would return.
+     *
+     * Key-up records left behind by _getch(), modifier keys, focus, mouse and resize
+     * events keep the console handle signalled, but _kbhit() ignores them and nothing
+     * else reads them, so without this the wait returns at once until the next key.
+     */
+    void discardNonKeyInput() {
+#ifdef _WIN32
+        const HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+        INPUT_RECORD record;
+        DWORD count = 0;
+        // The first record is peeked before _kbhit() looks at all of them, so a key
+        // arriving in between is queued behind it and never discarded.
+        while (PeekConsoleInput(input, &record, 1, &count) && count == 1 && !_kbhit()) {
+            ReadConsoleInput(input, &record, 1, &count);
+        }
+#endif
+    }
+}
+
+KeyboardReader::KeyboardReader(KeyQueue *keyQueue, const std::chrono::microseconds pollInterval) {
+    this->keyQueue = keyQueue;
+    this->pollInterval = pollInterval;
+    this->running = false;
+}
+
+KeyboardReader::~KeyboardReader() {
+    stop();
+}
+
+void KeyboardReader::start() {
+    running = true;
+    readerThread = std::thread(&KeyboardReader::run, this);
+}
+
+void KeyboardReader::stop() {
+    running = false;
+    if (readerThread.joinable()) {
+        readerThread.join();
+    }
+}
+
+void KeyboardReader::run() {
+    while (running) {
+        waitForConsoleInput(pollInterval);
+        while (running && _kbhit()) {
+            KeyPress press;
+            press.key = _getch();
+            if (press.key == 0 || press.key == 224) {
+                press.key = _getch();
+                press.extended = true;
+            }
+            // A full queue means the main loop is stuck; dropping keys beats blocking the console.
+            keyQueue->tryEnqueue(std::move(press));
+        }
+        discardNonKeyInput();
+    }
+}
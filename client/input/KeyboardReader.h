@@ -0,0 +1,62 @@
+#ifndef KEYBOARDREADER_H
+#define KEYBOARDREADER_H
+
+#include "../event/SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/**
+ * @brief One key read from the console.
+ */
+struct KeyPress {
+    int key = 0;
+    /** @brief The key came after a 0 or 224 prefix (arrows, function keys). */
+    bool extended = false;
+};
+
+/** @brief Keys read by the KeyboardReader thread, consumed by the InputHandler on the main loop. */
+using KeyQueue = SpscQueue<KeyPress, 64>;
+
+/**
+ * @brief Reads the console keyboard on its own thread.
+ *
+ * The thread sleeps until the console has input, reads every pending key and pushes
+ * it to the key queue, whose notifier wakes the main loop. The main loop therefore
+ * never polls the keyboard.
+ */
+class KeyboardReader {
+private:
+    KeyQueue *keyQueue;
+    std::chrono::microseconds pollInterval;
+    std::thread readerThread;
+    std::atomic<bool> running;
+
+    /**
+     * @brief The main loop of the reader thread.
+     */
+    void run();
+
+public:
+    /**
+     * @brief Constructs the KeyboardReader.
+     * @param keyQueue The queue where read keys are pushed.
+     * @param pollInterval Poll period where the console cannot signal input. Where it
+     * can (Windows), the thread waits on the console instead and ignores this.
+     */
+    KeyboardReader(KeyQueue *keyQueue, std::chrono::microseconds pollInterval);
+
+    ~KeyboardReader();
+
+    /**
+     * @brief Starts the reader thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops the reader thread; returns within one poll interval, at most 100 ms on Windows.
+     */
+    void stop();
+};
+
+#endif //KEYBOARDREADER_H
@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "Application.h"
+#include "utils/Logger.h"
 #include <string>
 #include <ixwebsocket/IXNetSystem.h>
 
@@ -20,6 +21,98 @@ void EnableVTMode() {
 }
 #endif
 
+namespace {
+    void printUsage(const char *program) {
+        std::cout << "Usage: " << program << " <server_url> [--fps N] [--input-hz N] [--network-hz N]"
+                     " [--log-level LEVEL] [--log-format FORMAT] [--history N] [--record FILE] [--capture FILE]" << std::endl;
+        std::cout << "       " << program << " --replay FILE [--replay-fast] [options]" << std::endl;
+        std::cout << "Example: " << program << " ws://localhost:8080/game --fps 30" << std::endl;
+        std::cout << "  --fps N         Draw at most N frames per second (default 60)." << std::endl;
+        std::cout << "  --input-hz N    Poll the keyboard N times per second where the console cannot signal keys (default 1000)." << std::endl;
+        std::cout << "  --network-hz N  Apply server events N times per second, 0 = on arrival (default 0)." << std::endl;
+        std::cout << "  --log-level L   debug, info, warning, severe or off (default debug)." << std::endl;
+        std::cout << "  --log-format F  text or binary (default text)." << std::endl;
+        std::cout << "  --history N     Chat and log lines kept for scrolling back (default "
+                  << GameState::DefaultHistoryDepth << ")." << std::endl;
+        std::cout << "  --record FILE   Write every frame received from the server to FILE, for --replay." << std::endl;
+        std::cout << "  --capture FILE  Write every frame sent and received to FILE." << std::endl;
+        std::cout << "  --replay FILE   Play a recording instead of connecting to a server." << std::endl;
+        std::cout << "  --replay-fast   Replay without the recorded pauses between frames." << std::endl;
+    }
+
+    /**
+     * @brief Everything that can be set on the command line after the server URL.
+     */
+    struct Options {
+        ApplicationOptions application;
+        LogConfig logConfig;
+        /** @brief Parsed here, copied into application.historyDepth. */
+        int historyDepth = static_cast<int>(GameState::DefaultHistoryDepth);
+    };
+
+    /**
+     * @brief Reads the options following the server URL.
+     * @param first Index of the first option in argv.
+     * @return False on an unknown option or a missing or invalid value.
+     */
+    bool parseOptions(const int argc, char *argv[], const int first, Options &options) {
+        ScheduleConfig &schedule = options.application.schedule;
+        LogConfig &logConfig = options.logConfig;
+        for (int i = first; i < argc; ++i) {
+            const std::string option = argv[i];
+            if (option == "--replay-fast") {
+                options.application.replayAsFastAsPossible = true;
+                continue;
+            }
+            if (option == "--log-level" || option == "--log-format" || option == "--record" || option == "--capture"
+                || option == "--replay") {
+                if (i + 1 >= argc) {
+                    return false;
+                }
+                const std::string value = argv[++i];
+                if (option == "--record" || option == "--capture") {
+                    options.application.capturePath = value;
+                    options.application.captureOutbound = option == "--capture";
+                } else if (option == "--replay") {
+                    options.application.replayPath = value;
+                } else if (option == "--log-level") {
+                    if (!Logger::levelFromName(value, logConfig.level)) return false;
+                } else if (value == "text") {
+                    logConfig.format = LogFormat::TEXT;
+                } else if (value == "binary") {
+                    logConfig.format = LogFormat::BINARY;
+                } else {
+                    return false;
+                }
+                continue;
+            }
+            int *target = nullptr;
+            int minimum = 1;
+            if (option == "--fps") target = &schedule.renderFps;
+            else if (option == "--input-hz") target = &schedule.inputHz;
+            else if (option == "--network-hz") {
+                target = &schedule.networkHz;
+                minimum = 0;
+            } else if (option == "--history") target = &options.historyDepth;
+            if (target == nullptr || i + 1 >= argc) {
+                return false;
+            }
+            try {
+                std::size_t parsed = 0;
+                const std::string value = argv[++i];
+                *target = std::stoi(value, &parsed);
+                if (parsed != value.size() || *target < minimum) {
+                    return false;
+                }
+            } catch (const std::exception &) {
+                return false;
+            }
+        }
+        options.application.historyDepth = static_cast<std::size_t>(options.historyDepth);
+        return true;
+    }
+}
+
 int main(const int argc, char* argv[]) {
     ix::initNetSystem();
     #ifdef _WIN32
@@ -28,16 +121,29 @@ int main(const int argc, char* argv[]) {
 
     {
         std::string url;
-        if (argc > 1) {
+        Options options;
+        // A replay needs no server, so the URL may be left out.
+        const bool hasUrl = argc > 1 && std::string(argv[1]).rfind("--", 0) != 0;
+        if (hasUrl) {
             url = argv[1];
-        } else {
-            std::cout << "Usage: " << argv[0] << " <server_url>" << std::endl;
-            std::cout << "Example: " << argv[0] << " ws://localhost:8080/game" << std::endl;
+        }
+        if (!parseOptions(argc, argv, hasUrl ? 2 : 1, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!hasUrl && options.application.replayPath.empty()) {
+            printUsage(argv[0]);
             std::cout << "Please provide the server URL as an argument." << std::endl;
             return 1;
         }
-        const Application app(url);
-        app.execute();
+        if (!Logger::start(options.logConfig)) {
+            std::cout << "Cannot open " << options.logConfig.path << ", logging is disabled." << std::endl;
+        }
+        {
+            const Application app(url, options.application);
+            app.execute();
+        }
+        Logger::stop();
     }
 
     ix::uninitNetSystem();
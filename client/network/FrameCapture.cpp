@@ -0,0 +1,102 @@
+#include "FrameCapture.h"
+
+namespace {
+    /** @brief stdio buffer of the capture file; a full map frame fits several times. */
+    constexpr std::size_t FileBufferSize = 1024 * 1024;
+    /** @brief Larger lengths mean a damaged file rather than a real frame. */
+    constexpr uint64_t MaxFrameSize = 64 * 1024 * 1024;
+
+    void putLittleEndian(char *out, uint64_t value, const int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out[i] = static_cast<char>(value & 0xFF);
+            value >>= 8;
+        }
+    }
+
+    uint64_t readLittleEndian(const unsigned char *in, const int bytes) {
+        uint64_t value = 0;
+        for (int i = bytes - 1; i >= 0; --i) {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+}
+
+FrameCapture::FrameCapture(const std::string &path) {
+    this->file = std::fopen(path.c_str(), "wb");
+    this->startTime = std::chrono::steady_clock::now();
+    if (file) {
+        fileBuffer = std::make_unique<char[]>(FileBufferSize);
+        std::setvbuf(file, fileBuffer.get(), _IOFBF, FileBufferSize);
+        std::fwrite(Magic.data(), 1, Magic.size(), file);
+    }
+}
+
+FrameCapture::~FrameCapture() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool FrameCapture::isOpen() const {
+    return file != nullptr;
+}
+
+void FrameCapture::write(const FrameDirection direction, const WireFormat format, const std::string_view frame) {
+    if (!file) {
+        return;
+    }
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    char header[RecordHeaderSize];
+    putLittleEndian(header, static_cast<uint64_t>(micros), 8);
+    putLittleEndian(header + 8, static_cast<uint8_t>(direction), 1);
+    putLittleEndian(header + 9, static_cast<uint8_t>(format), 1);
+    putLittleEndian(header + 10, static_cast<uint32_t>(frame.size()), 4);
+
+    std::lock_guard lock(fileMutex);
+    std::fwrite(header, 1, sizeof(header), file);
+    std::fwrite(frame.data(), 1, frame.size(), file);
+}
+
+CaptureReader::CaptureReader(const std::string &path) : file(std::fopen(path.c_str(), "rb")) {
+    std::string magic(FrameCapture::Magic.size(), '\0');
+    if (file && (std::fread(magic.data(), 1, magic.size(), file.get()) != magic.size()
+                 || magic != FrameCapture::Magic)) {
+        file.reset();
+    }
+}
+
+bool CaptureReader::isOpen() const {
+    return file != nullptr;
+}
+
+bool CaptureReader::next(CapturedFrame &frame) {
+    unsigned char header[FrameCapture::RecordHeaderSize];
+    if (!file || damaged) {
+        return false;
+    }
+    const std::size_t read = std::fread(header, 1, sizeof(header), file.get());
+    if (read != sizeof(header)) {
+        damaged = read != 0;
+        return false;
+    }
+    const uint64_t length = readLittleEndian(header + 10, 4);
+    if (length > MaxFrameSize) {
+        damaged = true;
+        return false;
+    }
+    frame.recordedAt = std::chrono::microseconds(readLittleEndian(header, 8));
+    frame.direction = static_cast<FrameDirection>(header[8]);
+    frame.format = static_cast<WireFormat>(header[9]);
+    frame.bytes.resize(length);
+    if (std::fread(frame.bytes.data(), 1, frame.bytes.size(), file.get()) != frame.bytes.size()) {
+        damaged = true;
+        return false;
+    }
+    return true;
+}
+
+bool CaptureReader::isDamaged() const {
+    return damaged;
+}
@@ -0,0 +1,123 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "WireFormat.h"
+
+/**
+ * @brief Direction of a captured frame.
+ */
+enum class FrameDirection : std::uint8_t {
+    IN,
+    OUT
+};
+
+/**
+ * @brief Writes WebSocket frames, complete and unmodified, to a file for offline analysis.
+ *
+ * The file starts with the line "AFTCAP1" followed by one record per frame: uint64
+ * microseconds of a monotonic clock since the capture was opened, uint8 direction,
+ * uint8 wire format, uint32 frame length (all little-endian), then the frame bytes.
+ *
+ * Written from the network threads through a large stdio buffer and flushed only
+ * when the buffer fills and on close, so capturing costs a copy per frame.
+ *
+ * --capture hands the capture to NetworkHandler and NetworkSender, so both
+ * directions are written. --record hands it to NetworkHandler only, which gives a
+ * recording of the received frames for FrameReplay; a replay skips OUT records
+ * either way, so both kinds of file can be replayed.
+ */
+class FrameCapture {
+private:
+    std::mutex fileMutex;
+    std::FILE *file = nullptr;
+    std::unique_ptr<char[]> fileBuffer;
+    std::chrono::steady_clock::time_point startTime;
+
+public:
+    /** @brief First line of a capture file. */
+    static constexpr std::string_view Magic = "AFTCAP1\n";
+    /** @brief Bytes in front of every frame: timestamp, direction, format and length. */
+    static constexpr std::size_t RecordHeaderSize = 14;
+
+    /**
+     * @brief Creates or truncates the capture file.
+     * @param path The file to write; check isOpen() afterwards.
+     */
+    explicit FrameCapture(const std::string &path);
+
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture &) = delete;
+
+    FrameCapture &operator=(const FrameCapture &) = delete;
+
+    /**
+     * @brief Checks whether the file could be opened.
+     */
+    [[nodiscard]] bool isOpen() const;
+
+    /**
+     * @brief Appends one frame. Safe from any thread.
+     * @param direction Whether the frame was received or sent.
+     * @param format The encoding of the frame.
+     * @param frame The frame bytes as they went over the wire.
+     */
+    void write(FrameDirection direction, WireFormat format, std::string_view frame);
+};
+
+/**
+ * @brief One frame read back from a capture file.
+ */
+struct CapturedFrame {
+    /** @brief Time since the capture was opened. */
+    std::chrono::microseconds recordedAt{0};
+    FrameDirection direction = FrameDirection::IN;
+    WireFormat format = WireFormat::JSON;
+    std::string bytes;
+};
+
+/**
+ * @brief Reads the frames of a file written by FrameCapture, in order.
+ */
+class CaptureReader {
+private:
+    struct FileCloser {
+        void operator()(std::FILE *file) const { std::fclose(file); }
+    };
+
+    std::unique_ptr<std::FILE, FileCloser> file;
+    bool damaged = false;
+
+public:
+    /**
+     * @brief Opens a capture file; check isOpen() afterwards.
+     */
+    explicit CaptureReader(const std::string &path);
+
+    /**
+     * @brief Checks whether the file could be opened and starts like a capture file.
+     */
+    [[nodiscard]] bool isOpen() const;
+
+    /**
+     * @brief Reads the next frame.
+     * @param frame Receives the frame; its buffer is reused between calls.
+     * @return False at the end of the file or at a damaged record, see isDamaged().
+     */
+    bool next(CapturedFrame &frame);
+
+    /**
+     * @brief Checks whether reading stopped at a truncated or damaged record rather than the end of the file.
+     */
+    [[nodiscard]] bool isDamaged() const;
+};
+
+#endif //FRAMECAPTURE_H
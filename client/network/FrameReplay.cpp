@@ -0,0 +1,103 @@
+#include "FrameReplay.h"
+#include "FrameCapture.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Longest single sleep while waiting for a frame's time, so stop() is noticed quickly. */
+    constexpr auto MaxPacingSleep = std::chrono::milliseconds(50);
+}
+
+FrameReplay::FrameReplay(const std::string &path, SpscQueue<GameEvent> *inputQueue, const bool asFastAsPossible) {
+    this->path = path;
+    this->inputQueue = inputQueue;
+    this->asFastAsPossible = asFastAsPossible;
+    this->running = false;
+}
+
+FrameReplay::~FrameReplay() {
+    stop();
+}
+
+void FrameReplay::start() {
+    running = true;
+    replayThread = std::thread(&FrameReplay::run, this);
+}
+
+void FrameReplay::stop() {
+    running = false;
+    if (replayThread.joinable()) {
+        replayThread.join();
+    }
+}
+
+uint64_t FrameReplay::getFramesReplayed() const {
+    return framesReplayed.load(std::memory_order_relaxed);
+}
+
+bool FrameReplay::deliver(GameEvent event) {
+    while (!inputQueue->tryEnqueue(std::move(event))) {
+        if (!running) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void FrameReplay::deliverError(const std::string &message) {
+    Logger::log(LogLevel::WARNING, "REPLAY", message);
+    deliver(GameEvent(EventType::SEND_ERROR, dto::TextMessageResponse{message}, message));
+}
+
+void FrameReplay::run() {
+    CaptureReader reader(path);
+    if (!reader.isOpen()) {
+        deliverError("Cannot replay " + path + ": not a capture file");
+        return;
+    }
+    if (!deliver(GameEvent(EventType::CONNECTION_ESTABLISHED, {}))) {
+        return;
+    }
+
+    const auto start = Clock::now();
+    // The recording's clock mapped onto ours, fixed by the first frame so the replay starts at once.
+    std::optional<Clock::time_point> origin;
+    CapturedFrame frame;
+    while (running && reader.next(frame)) {
+        if (frame.direction != FrameDirection::IN) {
+            continue;
+        }
+        if (!origin) {
+            origin = Clock::now() - frame.recordedAt;
+        }
+        if (!asFastAsPossible) {
+            const auto due = *origin + frame.recordedAt;
+            for (auto now = Clock::now(); running && now < due; now = Clock::now()) {
+                std::this_thread::sleep_for(std::min<Clock::duration>(due - now, MaxPacingSleep));
+            }
+        }
+        try {
+            if (!deliver(parseEvent(frame.bytes, frame.format))) {
+                break;
+            }
+            framesReplayed.fetch_add(1, std::memory_order_relaxed);
+        } catch (const std::exception &e) {
+            deliverError(std::string("JSON Error: ") + e.what());
+        }
+    }
+    if (reader.isDamaged()) {
+        deliverError("Replay of " + path + " stopped at a damaged or truncated record");
+    }
+
+    if (Logger::enabled(LogLevel::INFO)) {
+        const auto took = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+        Logger::log(LogLevel::INFO, "REPLAY", "Replayed " + std::to_string(getFramesReplayed()) + " frames of "
+                                              + path + " in " + std::to_string(took) + " ms");
+    }
+}
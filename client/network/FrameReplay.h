@@ -0,0 +1,74 @@
+#ifndef FRAMEREPLAY_H
+#define FRAMEREPLAY_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "event/SpscQueue.h"
+#include "event/GameEvent.h"
+
+/**
+ * @brief Plays a FrameCapture recording back into the input queue instead of a server.
+ *
+ * Runs on its own thread and takes the place of NetworkHandler: it announces the
+ * connection, then decodes every received frame of the recording with parseEvent
+ * and pushes the event, exactly as NetworkHandler would have. Sent frames in the
+ * recording are skipped. Frames are released at their recorded times, or back to
+ * back when replaying as fast as possible, in which case a full input queue holds
+ * the replay back.
+ */
+class FrameReplay {
+private:
+    std::string path;
+    SpscQueue<GameEvent> *inputQueue;
+    bool asFastAsPossible;
+    std::thread replayThread;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> framesReplayed{0};
+
+    /**
+     * @brief The main loop of the replay thread.
+     */
+    void run();
+
+    /**
+     * @brief Pushes an event, waiting while the queue is full.
+     * @return False if the replay was stopped meanwhile.
+     */
+    bool deliver(GameEvent event);
+
+    /**
+     * @brief Pushes a SEND_ERROR event carrying the given text, like NetworkHandler does.
+     */
+    void deliverError(const std::string &message);
+
+public:
+    /**
+     * @brief Constructs the FrameReplay.
+     * @param path A file written by FrameCapture.
+     * @param inputQueue The queue the replayed events are pushed to; the replay is its only producer.
+     * @param asFastAsPossible Ignore the recorded timing.
+     */
+    FrameReplay(const std::string &path, SpscQueue<GameEvent> *inputQueue, bool asFastAsPossible);
+
+    ~FrameReplay();
+
+    /**
+     * @brief Starts the replay thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops the replay, wherever it is.
+     */
+    void stop();
+
+    /**
+     * @brief Number of frames pushed to the input queue so far.
+     */
+    [[nodiscard]] uint64_t getFramesReplayed() const;
+};
+
+#endif //FRAMEREPLAY_H
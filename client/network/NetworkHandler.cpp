@@ -1,46 +1,79 @@
 #include "NetworkHandler.h"
 
 #include "event/GameEvent.h"
+#include "utils/Logger.h"
 
-NetworkHandler::NetworkHandler(const std::string &url, BlockingQueue<GameEvent> *inputQueue) {
+NetworkHandler::NetworkHandler(const std::string &url, SpscQueue<GameEvent> *inputQueue,
+                               FrameCapture *frameCapture) {
     this->inputQueue = inputQueue;
+    this->frameCapture = frameCapture;
     webSocket = std::make_unique<ix::WebSocket>();
     webSocket->setUrl(url);
     init();
 }
 
-void NetworkHandler::init() const {
+void NetworkHandler::init() {
     webSocket->setOnMessageCallback([this](const ix::WebSocketMessagePtr &msg) {
         if (msg->type == ix::WebSocketMessageType::Message) {
             try {
-                const GameEvent gameEvent = parseEvent(msg->str);
-                this->inputQueue->enqueue(gameEvent);
+                const WireFormat format = msg->binary ? wireFormat.load() : WireFormat::JSON;
+                if (frameCapture) {
+                    frameCapture->write(FrameDirection::IN, format, msg->str);
+                }
+                GameEvent gameEvent = parseEvent(msg->str, format);
+                if (const auto *options = std::get_if<dto::LoginOptionsResponse>(&gameEvent.getMessage())) {
+                    updateCapabilities(options->capabilities);
+                    updateWireFormat(options->encoding);
+                }
+                this->inputQueue->enqueue(std::move(gameEvent));
             } catch (const std::exception& e) {
-                nlohmann::json root;
-                root["type"] = "SEND_ERROR";
-                root["payload"] = std::string("JSON Error: ") + e.what();
-                this->inputQueue->enqueue(GameEvent(EventType::SEND_ERROR, root));
+                enqueueError(std::string("JSON Error: ") + e.what());
             }
         } else if (msg->type == ix::WebSocketMessageType::Open) {
             this->inputQueue->enqueue(GameEvent(EventType::CONNECTION_ESTABLISHED, {}));
         } else if (msg->type == ix::WebSocketMessageType::Close) {
-            nlohmann::json root;
-            root["type"] = "SEND_ERROR";
-            root["payload"] = "Connection Closed: " + std::to_string(msg->closeInfo.code) + " " + msg->closeInfo.reason;
-            this->inputQueue->enqueue(GameEvent(EventType::SEND_ERROR, root));
+            batchingSupported = false;
+            wireFormat = WireFormat::JSON;
+            enqueueError("Connection Closed: " + std::to_string(msg->closeInfo.code) + " " + msg->closeInfo.reason);
         } else if (msg->type == ix::WebSocketMessageType::Error) {
-            nlohmann::json root;
-            root["type"] = "SEND_ERROR";
-            root["payload"] = "Connection Error: " + msg->errorInfo.reason;
-            this->inputQueue->enqueue(GameEvent(EventType::SEND_ERROR, root));
+            enqueueError("Connection Error: " + msg->errorInfo.reason);
         }
     });
 }
 
+void NetworkHandler::enqueueError(const std::string &message) const {
+    Logger::log(LogLevel::WARNING, "NET", message);
+    this->inputQueue->enqueue(GameEvent(EventType::SEND_ERROR, dto::TextMessageResponse{message}, message));
+}
+
+void NetworkHandler::updateCapabilities(const std::vector<std::string> &capabilities) {
+    bool batching = false;
+    for (const auto &capability: capabilities) {
+        if (capability == "BATCH") {
+            batching = true;
+        }
+    }
+    batchingSupported = batching;
+}
+
+void NetworkHandler::updateWireFormat(const std::string &encoding) {
+    WireFormat format = WireFormat::JSON;
+    wireFormatFromName(encoding, format);
+    wireFormat = format;
+}
+
 ix::WebSocket *NetworkHandler::getWebSocket() const {
     return webSocket.get();
 }
 
+bool NetworkHandler::supportsBatching() const {
+    return batchingSupported;
+}
+
+WireFormat NetworkHandler::getWireFormat() const {
+    return wireFormat;
+}
+
 void NetworkHandler::start() const {
     webSocket->start();
 }
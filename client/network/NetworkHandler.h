@@ -1,34 +1,62 @@
 #ifndef NETWORKHANDLER_H
 #define NETWORKHANDLER_H
 #include "ixwebsocket/IXWebSocket.h"
+#include <atomic>
 #include <string>
+#include <vector>
 
-#include "event/BlockingQueue.h"
+#include "event/SpscQueue.h"
 #include "event/GameEvent.h"
+#include "FrameCapture.h"
+#include "WireFormat.h"
 
 /**
  * @brief Manages the WebSocket connection to the server.
  *
  * This class handles the low-level network communication using IXWebSocket.
- * It receives messages from the server, parses them into GameEvents, and
- * pushes them into the input queue for the GameController to process.
+ * It receives messages from the server, parses and decodes them into GameEvents
+ * on the IXWebSocket thread, and pushes them into the input queue for the
+ * GameController to apply.
  */
 class NetworkHandler {
-    BlockingQueue<GameEvent> *inputQueue;
+    SpscQueue<GameEvent> *inputQueue;
     std::unique_ptr<ix::WebSocket> webSocket;
+    std::atomic<bool> batchingSupported{false};
+    std::atomic<WireFormat> wireFormat{WireFormat::JSON};
+    /** @brief Receives every inbound frame when capturing, otherwise null. */
+    FrameCapture *frameCapture;
 
     /**
      * @brief Configures the WebSocket callbacks and options.
      */
-    void init() const;
+    void init();
+
+    /**
+     * @brief Applies the capabilities the server attached to its login options.
+     * @param capabilities The advertised capability names.
+     */
+    void updateCapabilities(const std::vector<std::string> &capabilities);
+
+    /**
+     * @brief Switches to the wire format the server accepted in its login options.
+     * @param encoding The encoding name, empty or unknown keeps JSON text.
+     */
+    void updateWireFormat(const std::string &encoding);
+
+    /**
+     * @brief Pushes a SEND_ERROR event carrying the given text to the input queue.
+     * @param message The error text shown to the player.
+     */
+    void enqueueError(const std::string &message) const;
 
 public:
     /**
      * @brief Constructs the NetworkHandler.
      * @param url The WebSocket URL to connect to.
      * @param inputQueue The queue where received events will be pushed.
+     * @param frameCapture Optional capture file for the received frames.
      */
-    NetworkHandler(const std::string &url, BlockingQueue<GameEvent> *inputQueue);
+    NetworkHandler(const std::string &url, SpscQueue<GameEvent> *inputQueue, FrameCapture *frameCapture = nullptr);
 
     /**
      * @brief Returns the underlying WebSocket instance.
@@ -36,6 +64,18 @@ public:
      */
     [[nodiscard]] ix::WebSocket *getWebSocket() const;
 
+    /**
+     * @brief Checks whether the server accepts several events packed into one BATCH frame.
+     * @return True once the server advertised the "BATCH" capability.
+     */
+    [[nodiscard]] bool supportsBatching() const;
+
+    /**
+     * @brief Returns the negotiated encoding for frames in both directions.
+     * @return WireFormat::JSON until the server accepts a binary encoding.
+     */
+    [[nodiscard]] WireFormat getWireFormat() const;
+
     /**
      * @brief Starts the WebSocket connection.
      *
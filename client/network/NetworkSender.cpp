@@ -1,10 +1,31 @@
 #include "NetworkSender.h"
+#include "../utils/DtoCodec.h"
 #include <iostream>
 #include <nlohmann/json.hpp>
 
-NetworkSender::NetworkSender(BlockingQueue<GameEvent> *outputQueue, NetworkHandler *networkHandler) {
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Upper bound for a single wait, only matters if a wake-up is ever missed. */
+    constexpr auto MaxIdleWait = std::chrono::seconds(1);
+
+    uint64_t micros(const Clock::duration d) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+    }
+
+    void storeMax(std::atomic<uint64_t> &target, const uint64_t value) {
+        if (value > target.load(std::memory_order_relaxed)) {
+            target.store(value, std::memory_order_relaxed);
+        }
+    }
+}
+
+NetworkSender::NetworkSender(SpscQueue<GameEvent> *outputQueue, NetworkHandler *networkHandler,
+                             FrameCapture *frameCapture) {
     this->outputQueue = outputQueue;
+    this->networkHandler = networkHandler;
     this->ws = networkHandler->getWebSocket();
+    this->frameCapture = frameCapture;
     this->running = false;
 }
 
@@ -19,28 +40,91 @@ void NetworkSender::start() {
 
 void NetworkSender::stop() {
     running = false;
+    outputQueue->wake();
     if (senderThread.joinable()) {
         senderThread.join();
     }
 }
 
 void NetworkSender::run() {
+    std::vector<GameEvent> batch;
     while (running) {
-        if (GameEvent event(EventType::UNKNOWN, nullptr);
-            outputQueue->tryPop(event)) {
-            std::string msg = event.getPayload().dump();
-            ws->send(msg);
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        if (!outputQueue->wait(MaxIdleWait)) {
+            continue;
+        }
+
+        const auto drainedAt = Clock::now();
+        GameEvent event(EventType::UNKNOWN, nullptr);
+        while (outputQueue->tryPop(event)) {
+            const uint64_t waited = micros(drainedAt - event.getCreatedAt());
+            queueWaitMicros.fetch_add(waited, std::memory_order_relaxed);
+            storeMax(maxQueueWaitMicros, waited);
+            batch.push_back(std::move(event));
+        }
+        sendBatch(batch);
+        batch.clear();
+    }
+}
+
+void NetworkSender::sendBatch(std::vector<GameEvent> &batch) {
+    if (batch.empty()) {
+        return;
+    }
+
+    const WireFormat format = networkHandler->getWireFormat();
+    const auto sendStart = Clock::now();
+    if (batch.size() > 1 && networkHandler->supportsBatching()) {
+        nlohmann::json payloads = nlohmann::json::array();
+        payloads.get_ref<nlohmann::json::array_t &>().reserve(batch.size());
+        for (GameEvent &event: batch) {
+            // The mutable getPayload(), so the envelopes are moved into the batch, not copied.
+            payloads.push_back(std::move(event.getPayload()));
+        }
+        nlohmann::json frame;
+        frame["type"] = "BATCH";
+        frame["payload"] = std::move(payloads);
+        sendFrame(frame, format);
+        framesSent.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        for (const auto &event: batch) {
+            sendFrame(event.getPayload(), format);
         }
+        framesSent.fetch_add(batch.size(), std::memory_order_relaxed);
+    }
+    const uint64_t took = micros(Clock::now() - sendStart);
+
+    eventsSent.fetch_add(batch.size(), std::memory_order_relaxed);
+    batchesSent.fetch_add(1, std::memory_order_relaxed);
+    sendMicros.fetch_add(took, std::memory_order_relaxed);
+    storeMax(maxSendMicros, took);
+}
+
+void NetworkSender::sendFrame(const nlohmann::json &frame, const WireFormat format) {
+    const std::string data = encodeFrame(frame, format);
+    if (frameCapture) {
+        frameCapture->write(FrameDirection::OUT, format, data);
     }
+    if (format == WireFormat::JSON) {
+        ws->send(data);
+    } else {
+        ws->sendBinary(data);
+    }
+}
+
+SenderStats NetworkSender::getStats() const {
+    SenderStats stats;
+    stats.eventsSent = eventsSent.load(std::memory_order_relaxed);
+    stats.framesSent = framesSent.load(std::memory_order_relaxed);
+    stats.batchesSent = batchesSent.load(std::memory_order_relaxed);
+    stats.queueWaitMicros = queueWaitMicros.load(std::memory_order_relaxed);
+    stats.maxQueueWaitMicros = maxQueueWaitMicros.load(std::memory_order_relaxed);
+    stats.sendMicros = sendMicros.load(std::memory_order_relaxed);
+    stats.maxSendMicros = maxSendMicros.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void NetworkSender::sendPayDebt(int amount) {
-    nlohmann::json payload;
-    payload["amount"] = amount;
-    nlohmann::json root;
-    root["type"] = "PAY_DEBT";
-    root["payload"] = payload;
-    outputQueue->enqueue(GameEvent(EventType::PAY_DEBT, root));
+    dto::PayDebtRequest request;
+    request.amount = amount;
+    outputQueue->enqueue(GameEvent(EventType::PAY_DEBT, utils::DtoCodec::encodeRequest(request)));
 }
@@ -1,36 +1,79 @@
 #ifndef NETWORKSENDER_H
 #define NETWORKSENDER_H
 #include "NetworkHandler.h"
-#include "event/BlockingQueue.h"
+#include "event/SpscQueue.h"
 #include "event/GameEvent.h"
 #include <thread>
 #include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Snapshot of the NetworkSender counters. All durations are in microseconds.
+ */
+struct SenderStats {
+    uint64_t eventsSent = 0;      ///< Events handed to the WebSocket.
+    uint64_t framesSent = 0;      ///< WebSocket frames written (a BATCH frame counts once).
+    uint64_t batchesSent = 0;     ///< Number of drain passes that sent something.
+    uint64_t queueWaitMicros = 0; ///< Sum of the time events spent in the output queue.
+    uint64_t maxQueueWaitMicros = 0;
+    uint64_t sendMicros = 0;      ///< Sum of the time spent inside ws->send.
+    uint64_t maxSendMicros = 0;
+};
 
 /**
  * @brief Handles sending events from the client to the server.
  *
- * This class runs in a separate thread, consuming events from the output queue
- * and sending them over the WebSocket connection managed by NetworkHandler.
+ * This class runs in a separate thread that sleeps on the output queue until an
+ * event arrives, then drains everything pending and sends it in one pass. When the
+ * server advertises the BATCH capability the pass goes out as a single frame.
+ * Frames are encoded in the wire format negotiated by the NetworkHandler.
  */
 class NetworkSender {
 private:
-    BlockingQueue<GameEvent> *outputQueue;
+    SpscQueue<GameEvent> *outputQueue;
+    NetworkHandler *networkHandler;
     ix::WebSocket *ws;
+    /** @brief Receives every outbound frame when capturing, otherwise null. */
+    FrameCapture *frameCapture;
     std::thread senderThread;
     std::atomic<bool> running;
 
+    std::atomic<uint64_t> eventsSent{0};
+    std::atomic<uint64_t> framesSent{0};
+    std::atomic<uint64_t> batchesSent{0};
+    std::atomic<uint64_t> queueWaitMicros{0};
+    std::atomic<uint64_t> maxQueueWaitMicros{0};
+    std::atomic<uint64_t> sendMicros{0};
+    std::atomic<uint64_t> maxSendMicros{0};
+
     /**
      * @brief The main loop of the sender thread.
      */
     void run();
 
+    /**
+     * @brief Sends all events drained in one pass, batched into one frame if the server supports it.
+     * @param batch The drained events in queue order. Payloads may be moved out.
+     */
+    void sendBatch(std::vector<GameEvent> &batch);
+
+    /**
+     * @brief Writes one envelope to the WebSocket in the negotiated wire format.
+     * @param frame The envelope to send.
+     * @param format JSON goes out as a text message, the binary encodings as binary messages.
+     */
+    void sendFrame(const nlohmann::json &frame, WireFormat format);
+
 public:
     /**
      * @brief Constructs the NetworkSender.
      * @param outputQueue The queue from which events to send are consumed.
      * @param networkHandler The handler managing the WebSocket connection.
+     * @param frameCapture Optional capture file for the sent frames.
      */
-    NetworkSender(BlockingQueue<GameEvent> *outputQueue, NetworkHandler *networkHandler);
+    NetworkSender(SpscQueue<GameEvent> *outputQueue, NetworkHandler *networkHandler,
+                  FrameCapture *frameCapture = nullptr);
 
     ~NetworkSender();
 
@@ -44,6 +87,12 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Returns the current queue-wait and send-time counters.
+     * @return A consistent-enough snapshot for diagnostics.
+     */
+    [[nodiscard]] SenderStats getStats() const;
+
     /**
      * @brief Helper method to send a PAY_DEBT event.
      * @param amount The amount of credits to pay.
@@ -0,0 +1,99 @@
+#ifndef WIREFORMAT_H
+#define WIREFORMAT_H
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief Encoding of the WebSocket frames.
+ *
+ * Every connection starts in JSON text. The client offers the binary encodings in
+ * its INIT request and the server names the one it picked in the login options
+ * envelope; from then on both sides exchange binary frames with the same
+ * {"type", "payload"} envelope.
+ */
+enum class WireFormat {
+    JSON,
+    MSGPACK,
+    CBOR
+};
+
+/**
+ * @brief Binary encodings offered in the INIT request, most preferred first.
+ */
+inline const std::vector<WireFormat> OfferedWireFormats = {WireFormat::MSGPACK, WireFormat::CBOR};
+
+/**
+ * @brief Returns the protocol name of a wire format.
+ * @param format The wire format.
+ * @return "JSON", "MSGPACK" or "CBOR".
+ */
+inline const char *wireFormatName(const WireFormat format) {
+    switch (format) {
+        case WireFormat::MSGPACK: return "MSGPACK";
+        case WireFormat::CBOR: return "CBOR";
+        default: return "JSON";
+    }
+}
+
+/**
+ * @brief Resolves a protocol name sent by the server.
+ * @param name The name, e.g. "MSGPACK".
+ * @param format Receives the wire format if the name is known.
+ * @return True if the name is a supported encoding.
+ */
+inline bool wireFormatFromName(const std::string &name, WireFormat &format) {
+    for (const WireFormat candidate: {WireFormat::JSON, WireFormat::MSGPACK, WireFormat::CBOR}) {
+        if (name == wireFormatName(candidate)) {
+            format = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Maps a wire format to the matching nlohmann input format.
+ */
+inline nlohmann::json::input_format_t inputFormatOf(const WireFormat format) {
+    switch (format) {
+        case WireFormat::MSGPACK: return nlohmann::json::input_format_t::msgpack;
+        case WireFormat::CBOR: return nlohmann::json::input_format_t::cbor;
+        default: return nlohmann::json::input_format_t::json;
+    }
+}
+
+/**
+ * @brief Serializes an envelope for sending.
+ * @param frame The JSON envelope.
+ * @param format The negotiated wire format.
+ * @return JSON text, or the binary encoding as a byte string.
+ */
+inline std::string encodeFrame(const nlohmann::json &frame, const WireFormat format) {
+    std::string out;
+    switch (format) {
+        case WireFormat::MSGPACK: nlohmann::json::to_msgpack(frame, out); break;
+        case WireFormat::CBOR: nlohmann::json::to_cbor(frame, out); break;
+        default: out = frame.dump(); break;
+    }
+    return out;
+}
+
+/**
+ * @brief Builds the DOM of a received frame.
+ * @tparam Json The DOM type; parseEvent uses utils::FrameJson so the nodes come from the frame arena.
+ * @param frame The raw frame bytes.
+ * @param format The encoding of the frame.
+ * @return The parsed envelope; throws nlohmann::json::parse_error on malformed input.
+ */
+template<typename Json = nlohmann::json>
+Json decodeFrame(const std::string &frame, const WireFormat format) {
+    switch (format) {
+        case WireFormat::MSGPACK: return Json::from_msgpack(frame);
+        case WireFormat::CBOR: return Json::from_cbor(frame);
+        default: return Json::parse(frame);
+    }
+}
+
+#endif //WIREFORMAT_H
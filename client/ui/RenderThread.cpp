@@ -0,0 +1,104 @@
+#include "RenderThread.h"
+#include <algorithm>
+
+namespace {
+    using Clock = TickScheduler::Clock;
+
+    /** @brief Number of recent frames the percentiles are computed over. */
+    constexpr std::size_t FrameSamples = 1024;
+
+    uint64_t micros(const Clock::duration d) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+    }
+
+    uint64_t percentile(const std::vector<uint64_t> &sorted, const std::size_t percent) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        return sorted[std::min(sorted.size() - 1, sorted.size() * percent / 100)];
+    }
+}
+
+RenderThread::RenderThread(const ScheduleConfig &schedule) : scheduler(schedule) {
+    this->running = false;
+    this->frameMicros.reserve(FrameSamples);
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start() {
+    running = true;
+    renderThread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::stop() {
+    running = false;
+    wakeSignal.notify();
+    if (renderThread.joinable()) {
+        renderThread.join();
+    }
+}
+
+void RenderThread::publish(const GameState &state) {
+    RenderSnapshot &snapshot = snapshots.writeSlot();
+    snapshot.version = state.getVersion();
+    snapshot.sequence = ++published;
+    snapshot.view = static_cast<const GameView &>(state);
+    snapshots.publish();
+    wakeSignal.notify();
+}
+
+void RenderThread::run() {
+    while (running) {
+        const auto now = Clock::now();
+        // The frame cap applies here; a snapshot arriving early waits for its slot,
+        // and anything published meanwhile replaces it.
+        if (scheduler.frameDue(now)) {
+            drawFrame();
+        }
+        wakeSignal.waitUntil(scheduler.nextWake(Clock::now()));
+    }
+}
+
+void RenderThread::drawFrame() {
+    if (snapshots.refresh()) {
+        const uint64_t sequence = snapshots.readSlot().sequence;
+        if (sequence > taken + 1) {
+            framesDropped += sequence - taken - 1;
+        }
+        taken = sequence;
+    }
+
+    // Also called without a new snapshot, so a resized terminal gets redrawn.
+    const auto start = Clock::now();
+    const bool drawn = renderer.render(snapshots.readSlot());
+    const auto end = Clock::now();
+    scheduler.frameDone(start, end, drawn);
+    if (!drawn) {
+        return;
+    }
+
+    if (frameMicros.size() < FrameSamples) {
+        frameMicros.push_back(micros(end - start));
+    } else {
+        frameMicros[nextSample] = micros(end - start);
+        nextSample = (nextSample + 1) % FrameSamples;
+    }
+}
+
+RenderStats RenderThread::getStats() const {
+    RenderStats stats;
+    stats.budget = scheduler.getStats();
+    stats.framesSkipped = renderer.getFramesSkipped();
+    stats.framesDropped = framesDropped;
+    stats.bytesWritten = renderer.getBytesWritten();
+
+    std::vector<uint64_t> sorted = frameMicros;
+    std::sort(sorted.begin(), sorted.end());
+    stats.p50FrameMicros = percentile(sorted, 50);
+    stats.p95FrameMicros = percentile(sorted, 95);
+    stats.p99FrameMicros = percentile(sorted, 99);
+    return stats;
+}
@@ -0,0 +1,98 @@
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+#include "TuiRenderer.h"
+#include "../event/TripleBuffer.h"
+#include "../event/WakeSignal.h"
+#include "../game/GameState.h"
+#include "../game/TickScheduler.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Snapshot of the render thread counters. All durations are in microseconds.
+ */
+struct RenderStats {
+    FrameBudgetStats budget;
+    uint64_t framesSkipped = 0;  ///< Wake-ups with nothing new to draw.
+    uint64_t framesDropped = 0;  ///< Snapshots replaced by a newer one before they were drawn.
+    uint64_t bytesWritten = 0;   ///< Terminal output of all drawn frames.
+    uint64_t p50FrameMicros = 0; ///< Frame time percentiles over the most recent frames.
+    uint64_t p95FrameMicros = 0;
+    uint64_t p99FrameMicros = 0;
+};
+
+/**
+ * @brief Runs the TuiRenderer on its own thread.
+ *
+ * The main loop publishes snapshots of the game state; the render thread wakes up,
+ * waits for its next frame slot and draws whatever snapshot is newest by then.
+ * Snapshots published in between are dropped, so a slow terminal lowers the frame
+ * rate instead of delaying input or network processing.
+ */
+class RenderThread {
+private:
+    TuiRenderer renderer;
+    TripleBuffer<RenderSnapshot> snapshots;
+    WakeSignal wakeSignal;
+    TickScheduler scheduler;
+    std::thread renderThread;
+    std::atomic<bool> running;
+
+    /** @brief Sequence number of the last published snapshot. Publisher only. */
+    uint64_t published = 0;
+    /** @brief Sequence number of the last snapshot taken for drawing. Render thread only. */
+    uint64_t taken = 0;
+    uint64_t framesDropped = 0;
+    /** @brief Most recent frame times in microseconds, used as a ring. */
+    std::vector<uint64_t> frameMicros;
+    std::size_t nextSample = 0;
+
+    /**
+     * @brief The main loop of the render thread.
+     */
+    void run();
+
+    /**
+     * @brief Takes the newest snapshot, if any, and draws it.
+     */
+    void drawFrame();
+
+public:
+    /**
+     * @brief Constructs the RenderThread.
+     * @param schedule Only the render rate is used.
+     */
+    explicit RenderThread(const ScheduleConfig &schedule);
+
+    ~RenderThread();
+
+    /**
+     * @brief Starts the render thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops the render thread.
+     */
+    void stop();
+
+    /**
+     * @brief Copies the drawable part of the state into the next snapshot and wakes the render thread.
+     *
+     * Must always be called from the same thread, with the state mutex held.
+     * @param state The game state.
+     */
+    void publish(const GameState &state);
+
+    /**
+     * @brief Returns the frame counters and frame time percentiles.
+     *
+     * Only consistent after stop().
+     */
+    [[nodiscard]] RenderStats getStats() const;
+};
+
+#endif //RENDERTHREAD_H
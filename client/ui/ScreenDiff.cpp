@@ -0,0 +1,148 @@
+#include "ScreenDiff.h"
+
+using namespace ftxui;
+
+namespace {
+    /**
+     * @brief The SGR-relevant part of a pixel; tracks what the terminal currently applies.
+     */
+    struct TextStyle {
+        bool bold = false;
+        bool dim = false;
+        bool underlined = false;
+        bool blink = false;
+        bool inverted = false;
+        bool strikethrough = false;
+        bool underlinedDouble = false;
+        Color foreground;
+        Color background;
+
+        static TextStyle of(const Pixel &pixel) {
+            TextStyle style;
+            style.bold = pixel.bold;
+            style.dim = pixel.dim;
+            style.underlined = pixel.underlined;
+            style.blink = pixel.blink;
+            style.inverted = pixel.inverted;
+            style.strikethrough = pixel.strikethrough;
+            style.underlinedDouble = pixel.underlined_double;
+            style.foreground = pixel.foreground_color;
+            style.background = pixel.background_color;
+            return style;
+        }
+
+        [[nodiscard]] bool isDefault() const {
+            return !bold && !dim && !underlined && !blink && !inverted && !strikethrough && !underlinedDouble
+                   && foreground == Color() && background == Color();
+        }
+    };
+
+    bool sameCell(const Pixel &a, const Pixel &b) {
+        return a.character == b.character && a.bold == b.bold && a.dim == b.dim && a.underlined == b.underlined
+               && a.blink == b.blink && a.inverted == b.inverted && a.strikethrough == b.strikethrough
+               && a.underlined_double == b.underlined_double && a.foreground_color == b.foreground_color
+               && a.background_color == b.background_color;
+    }
+
+    void appendCode(std::string &codes, const std::string &code) {
+        if (!codes.empty()) codes += ';';
+        codes += code;
+    }
+
+    /**
+     * @brief Appends the SGR sequence that switches the terminal from `current` to `target`.
+     *
+     * Attributes that only turn on are added incrementally; turning any attribute off
+     * resets and reapplies the rest, which is shorter than the per-attribute off codes
+     * and avoids 22 clearing bold and dim together.
+     */
+    void switchStyle(std::string &out, TextStyle &current, const TextStyle &target) {
+        const bool turnsOff = (current.bold && !target.bold) || (current.dim && !target.dim)
+                              || (current.underlined && !target.underlined) || (current.blink && !target.blink)
+                              || (current.inverted && !target.inverted)
+                              || (current.strikethrough && !target.strikethrough)
+                              || (current.underlinedDouble && !target.underlinedDouble);
+        const TextStyle from = turnsOff ? TextStyle() : current;
+
+        std::string codes = turnsOff ? "0" : "";
+        if (target.bold && !from.bold) appendCode(codes, "1");
+        if (target.dim && !from.dim) appendCode(codes, "2");
+        if (target.underlined && !from.underlined) appendCode(codes, "4");
+        if (target.blink && !from.blink) appendCode(codes, "5");
+        if (target.inverted && !from.inverted) appendCode(codes, "7");
+        if (target.strikethrough && !from.strikethrough) appendCode(codes, "9");
+        if (target.underlinedDouble && !from.underlinedDouble) appendCode(codes, "21");
+        if (target.foreground != from.foreground) appendCode(codes, target.foreground.Print(false));
+        if (target.background != from.background) appendCode(codes, target.background.Print(true));
+
+        if (!codes.empty()) {
+            out += "\033[";
+            out += codes;
+            out += 'm';
+        }
+        current = target;
+    }
+
+    /**
+     * @brief Moves the cursor from (cursorX, cursorY) to (x, y); a negative cursorY means unknown.
+     */
+    void moveCursor(std::string &out, const int cursorX, const int cursorY, const int x, const int y) {
+        if (cursorY == y && cursorX == x) return;
+        if (cursorY == y && cursorX < x) {
+            out += "\033[";
+            if (x - cursorX > 1) out += std::to_string(x - cursorX);
+            out += 'C';
+            return;
+        }
+        out += "\033[";
+        out += std::to_string(y + 1);
+        out += ';';
+        out += std::to_string(x + 1);
+        out += 'H';
+    }
+}
+
+void ScreenDiff::diff(const Screen &screen, std::string &out) {
+    if (screen.dimx() != width || screen.dimy() != height) {
+        width = screen.dimx();
+        height = screen.dimy();
+        previous.assign(static_cast<std::size_t>(width) * height, Pixel());
+        out += "\033[0m\033[2J";
+    }
+
+    TextStyle current;
+    int cursorX = -1;
+    int cursorY = -1;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const Pixel &pixel = screen.PixelAt(x, y);
+            // The right half of a wide glyph is written together with its left half.
+            if (pixel.character.empty()) continue;
+
+            const std::size_t index = static_cast<std::size_t>(y) * width + x;
+            const bool wide = x + 1 < width && screen.PixelAt(x + 1, y).character.empty();
+            if (sameCell(pixel, previous[index]) && (!wide || sameCell(screen.PixelAt(x + 1, y), previous[index + 1]))) {
+                continue;
+            }
+
+            moveCursor(out, cursorX, cursorY, x, y);
+            switchStyle(out, current, TextStyle::of(pixel));
+            out += pixel.character;
+
+            previous[index] = pixel;
+            if (wide) previous[index + 1] = screen.PixelAt(x + 1, y);
+            cursorX = x + (wide ? 2 : 1);
+            cursorY = y;
+        }
+    }
+
+    if (!current.isDefault()) {
+        out += "\033[0m";
+    }
+}
+
+void ScreenDiff::invalidate() {
+    width = 0;
+    height = 0;
+    previous.clear();
+}
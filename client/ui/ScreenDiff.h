@@ -0,0 +1,40 @@
+#ifndef SCREENDIFF_H
+#define SCREENDIFF_H
+
+#include <string>
+#include <vector>
+#include <ftxui/screen/screen.hpp>
+
+/**
+ * @brief Turns consecutive FTXUI frames into the terminal output that updates only the cells that changed.
+ *
+ * Keeps the cells of the frame last written. Each new frame is compared cell by cell
+ * and only cells whose glyph or style differ are written, with absolute or forward
+ * cursor moves between them and SGR sequences only where the style changes. The
+ * output assumes the frame is drawn at the top left corner of the terminal.
+ */
+class ScreenDiff {
+public:
+    /**
+     * @brief Appends the escape sequences and glyphs that turn the previous frame into this one.
+     *
+     * The first frame, and any frame of a different size, clears the terminal and is
+     * written in full.
+     * @param screen The rendered frame.
+     * @param out Where the output is appended; nothing is appended if no cell changed.
+     */
+    void diff(const ftxui::Screen &screen, std::string &out);
+
+    /**
+     * @brief Forgets the previous frame so the next one is written in full.
+     */
+    void invalidate();
+
+private:
+    int width = 0;
+    int height = 0;
+    /** @brief Cells as the terminal shows them now, row-major. */
+    std::vector<ftxui::Pixel> previous;
+};
+
+#endif //SCREENDIFF_H
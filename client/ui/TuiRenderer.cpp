@@ -1,6 +1,8 @@
 #include "TuiRenderer.h"
+#include <ftxui/screen/terminal.hpp>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <algorithm>
 
 using namespace ftxui;
@@ -13,7 +15,8 @@ namespace {
     constexpr int MapMaxWidth = 154;
     constexpr int WindowWidth = 160;
     constexpr int WindowHeight = 50;
-    constexpr int LogsHeight = 12;
+    /** @brief Both log windows, the separator between them and the border. */
+    constexpr int LogsHeight = GameState::GameLogRows + GameState::NetworkLogRows + 3;
     constexpr int LoginWidth = 80;
     constexpr int InventoryWidth = 50;
     constexpr int InventoryHeight = 15;
@@ -25,22 +28,74 @@ namespace {
     constexpr int PayDebtWidth = 40;
     constexpr int AnnouncementWidth = 60;
     constexpr int DialogWidth = 60;
-}
 
-std::vector<std::string> split_utf8(const std::string& str) {
-    std::vector<std::string> chars;
-    for (size_t i = 0; i < str.length();) {
-        int cplen = 1;
-        const auto c = static_cast<unsigned char>(str[i]);
-        if ((c & 0xF8) == 0xF0) cplen = 4;
-        else if ((c & 0xF0) == 0xE0) cplen = 3;
-        else if ((c & 0xE0) == 0xC0) cplen = 2;
-
-        if (i + cplen > str.length()) cplen = 1;
-        chars.push_back(str.substr(i, cplen));
-        i += cplen;
+    /** @brief Symbols drawn over the map tiles, addressed as GlyphTable::ReservedBase + index. */
+    const std::string OverlaySymbols[] = {"?", "■", ">", "=", "E", "M", "T", "H", "N", "P", "@"};
+
+    enum Overlay : GlyphId {
+        OBJECT_UNKNOWN = GlyphTable::ReservedBase,
+        OBJECT_CONTAINER,
+        OBJECT_EXIT,
+        OBJECT_BED,
+        NPC_UNNAMED,
+        NPC_MONSTER,
+        NPC_TRADER,
+        NPC_HEALER,
+        NPC_OTHER,
+        OTHER_PLAYER,
+        SELF
+    };
+
+    /** @brief How a map cell is decorated; decided once per glyph, not per cell. */
+    enum class CellStyle : std::uint8_t {
+        PLAIN, SELF, PLAYER, MONSTER, NPC, TRADER, HEALER, CONTAINER, EXIT, STRUCTURE, FLOOR
+    };
+
+    CellStyle styleOfGlyph(const std::string &cell) {
+        if (cell == "@") return CellStyle::SELF;
+        if (cell == "P") return CellStyle::PLAYER;
+        if (cell == "M") return CellStyle::MONSTER;
+        if (cell == "N") return CellStyle::NPC;
+        if (cell == "T") return CellStyle::TRADER;
+        if (cell == "H") return CellStyle::HEALER;
+        if (cell == "■") return CellStyle::CONTAINER;
+        if (cell == ">") return CellStyle::EXIT;
+        if (cell == "=" || cell == "#" || cell == "┌" || cell == "┐" || cell == "└" || cell == "┘" || cell == "─" || cell == "│") {
+            return CellStyle::STRUCTURE;
+        }
+        if (cell == ".") return CellStyle::FLOOR;
+        return CellStyle::PLAIN;
+    }
+
+    Element styled(Element t, const CellStyle style) {
+        switch (style) {
+            case CellStyle::SELF: return t | color(Color::GreenLight) | bold;
+            case CellStyle::PLAYER: return t | color(Color::BlueLight) | bold;
+            case CellStyle::MONSTER: return t | color(Color::Red) | bold;
+            case CellStyle::NPC: return t | color(Color::Green) | bold;
+            case CellStyle::TRADER: return t | color(Color::Gold1) | bold;
+            case CellStyle::HEALER: return t | color(Color::Magenta1) | bold;
+            case CellStyle::CONTAINER: return t | color(Color::Yellow);
+            case CellStyle::EXIT: return t | color(Color::Green);
+            case CellStyle::STRUCTURE: return t | color(Color::Cyan);
+            case CellStyle::FLOOR: return t | color(Color::GrayDark);
+            default: return t;
+        }
+    }
+
+    /**
+     * @brief Text of a network log entry; built only for the entries on screen.
+     */
+    std::string describeFrame(const dto::NetworkLogDto &log) {
+        if (log.encoding) {
+            return std::string("<") + log.encoding + " " + std::to_string(log.size) + " B>";
+        }
+        std::string text(log.preview.data(), log.previewLength);
+        if (log.size > log.previewLength) {
+            text += "... (" + std::to_string(log.size) + " B)";
+        }
+        return text;
     }
-    return chars;
 }
 
 Color getRarityColor(const std::string& rarity) {
@@ -57,9 +112,36 @@ TuiRenderer::TuiRenderer() {
 TuiRenderer::~TuiRenderer() {
 }
 
-void TuiRenderer::render(const GameState &state) {
-    std::lock_guard lock(state.stateMutex);
+bool TuiRenderer::render(const RenderSnapshot &snapshot) {
+    // A resized terminal has to be redrawn even if the state did not change.
+    const auto terminal = Terminal::Size();
+    if (snapshot.version == renderedVersion && terminal.dimx == renderedWidth && terminal.dimy == renderedHeight) {
+        ++framesSkipped;
+        return false;
+    }
+    renderedVersion = snapshot.version;
+    renderedWidth = terminal.dimx;
+    renderedHeight = terminal.dimy;
+
+    const Element document = buildFrame(snapshot.view);
 
+    auto screen = Screen::Create(Dimension::Full(), Dimension::Full());
+    if (screen.dimx() <= 1 || screen.dimy() <= 1) {
+        screen = Screen::Create(Dimension::Fixed(WindowWidth), Dimension::Fixed(WindowHeight));
+    }
+
+    Render(screen, document);
+
+    frameOutput.clear();
+    screenDiff.diff(screen, frameOutput);
+    std::cout.write(frameOutput.data(), static_cast<std::streamsize>(frameOutput.size()));
+    std::cout << std::flush;
+    bytesWritten += frameOutput.size();
+    ++framesRendered;
+    return true;
+}
+
+Element TuiRenderer::buildFrame(const GameView &state) {
     Element content;
 
     if (state.clientState == ClientState::LOGIN_SCREEN || state.clientState == ClientState::WAITING_FOR_INIT) {
@@ -102,16 +184,23 @@ void TuiRenderer::render(const GameState &state) {
             }
             log_elements.push_back(separator());
             for (const auto& log : state.networkLogs) {
-                auto c = (log.direction == "OUT") ? Color::Blue : Color::Green;
-                auto arrow = (log.direction == "OUT") ? "->" : "<-";
+                const bool outbound = std::string_view(log.direction) == "OUT";
+                auto c = outbound ? Color::Blue : Color::Green;
+                auto arrow = outbound ? "->" : "<-";
                 log_elements.push_back(hbox({
                     text(arrow) | color(c),
-                    text(" " + log.type + " "),
-                    text(log.payload) | dim
+                    text(std::string(" ") + log.type + " "),
+                    text(describeFrame(log)) | dim
                 }));
             }
 
             auto log_title = text(" SYSTEM LOGS ");
+            if (state.gameLogScroll > 0 || state.networkLogScroll > 0) {
+                log_title = text(" SYSTEM LOGS  game -" + std::to_string(state.gameLogScroll) + "/"
+                                 + std::to_string(state.gameLogCount) + "  net -"
+                                 + std::to_string(state.networkLogScroll) + "/"
+                                 + std::to_string(state.networkLogCount) + "  (End = newest) ");
+            }
             if (!state.lastError.empty()) {
                 log_title = text(" WARNING: " + state.lastError + " ") | color(Color::Red) | bold;
             }
@@ -126,32 +215,27 @@ void TuiRenderer::render(const GameState &state) {
         });
     }
 
-    const Element document = content
+    return content
         | size(WIDTH, EQUAL, WindowWidth)
         | size(HEIGHT, EQUAL, WindowHeight)
         | borderStyled(ROUNDED)
         | color(Color::Cyan)
         | center;
+}
 
-    auto screen = Screen::Create(Dimension::Full(), Dimension::Full());
-    if (screen.dimx() <= 1 || screen.dimy() <= 1) {
-        screen = Screen::Create(Dimension::Fixed(WindowWidth), Dimension::Fixed(WindowHeight));
-    }
-
-    Render(screen, document);
+std::uint64_t TuiRenderer::getFramesRendered() const {
+    return framesRendered;
+}
 
-    if (last_reset_position.empty()) {
-        std::cout << "\033[2J\033[H";
-    } else {
-        std::cout << last_reset_position;
-    }
+std::uint64_t TuiRenderer::getFramesSkipped() const {
+    return framesSkipped;
+}
 
-    screen.Print();
-    std::cout << std::flush;
-    last_reset_position = screen.ResetPosition();
+std::uint64_t TuiRenderer::getBytesWritten() const {
+    return bytesWritten;
 }
 
-Element TuiRenderer::buildLoginScreen(const GameState &state) {
+Element TuiRenderer::buildLoginScreen(const GameView &state) {
     auto logo = vbox({
         text(R"(    ___     ______ ______ ______ ____  __  ___  ___  ______ __  __  )") | color(Color::Cyan),
         text(R"(   /   |   / ____//_  __// ____// __ \/  |/  / /   |/_  __/ / / /   )") | color(Color::Cyan),
@@ -205,17 +289,15 @@ Element TuiRenderer::buildLoginScreen(const GameState &state) {
     return content | size(WIDTH, EQUAL, LoginWidth) | borderStyled(ROUNDED) | color(Color::Cyan) | center;
 }
 
-Element TuiRenderer::buildMap(const GameState &state) {
+Element TuiRenderer::buildMap(const GameView &state) {
     int rangeX = state.map.rangeX;
     int rangeY = state.map.rangeY;
 
-    if (rangeX == 0 && rangeY == 0 && !state.map.layers.empty()) {
-        for (const auto& [key, rows] : state.map.layers) {
-            if (!rows.empty()) {
-                rangeY = rows.size() / 2;
-                if (!rows[0].empty()) {
-                    rangeX = split_utf8(rows[0]).size() / 2;
-                }
+    if (rangeX == 0 && rangeY == 0 && !state.tileLayers.empty()) {
+        for (const auto& [key, layer] : state.tileLayers) {
+            if (layer.height > 0) {
+                rangeY = layer.height / 2;
+                rangeX = layer.width / 2;
                 break;
             }
         }
@@ -237,95 +319,92 @@ Element TuiRenderer::buildMap(const GameState &state) {
     const int offsetX = clientTopLeftX - serverTopLeftX;
     const int offsetY = clientTopLeftY - serverTopLeftY;
 
-    std::vector display_grid(height, std::vector<std::string>(width, " "));
-
-    std::string currentLayerKey = std::to_string(state.map.centerZ);
-    if (state.map.layers.count(currentLayerKey)) {
-        const auto& rows = state.map.layers.at(currentLayerKey);
+    mapCells.assign(static_cast<std::size_t>(width) * height, GlyphTable::Blank);
+    const auto place = [&](const int relX, const int relY, const GlyphId id) {
+        if (relY >= 0 && relY < height && relX >= 0 && relX < width) {
+            mapCells[static_cast<std::size_t>(relY) * width + relX] = id;
+        }
+    };
 
+    const auto layerIt = state.tileLayers.find(std::to_string(state.map.centerZ));
+    if (layerIt != state.tileLayers.end()) {
+        const TileLayer &layer = layerIt->second;
         for (int y = 0; y < height; ++y) {
             const int serverY = y + offsetY;
-            if (serverY >= 0 && serverY < rows.size()) {
-                std::vector<std::string> row_chars = split_utf8(rows[serverY]);
-                for (int x = 0; x < width; ++x) {
-                    const int serverX = x + offsetX;
-                    if (serverX >= 0 && serverX < row_chars.size()) {
-                        if (row_chars[serverX] != " ") {
-                            display_grid[y][x] = row_chars[serverX];
-                        }
-                    }
+            if (serverY < 0 || serverY >= layer.height) continue;
+            for (int x = 0; x < width; ++x) {
+                const int serverX = x + offsetX;
+                if (serverX >= 0 && serverX < layer.width) {
+                    mapCells[static_cast<std::size_t>(y) * width + x] = layer.at(serverX, serverY);
                 }
             }
         }
     }
 
-    for (const auto &obj: state.objects) {
-        if (obj.z != state.player.layerIndex) continue;
-
-        const int relX = obj.x - clientTopLeftX;
-        const int relY = obj.y - clientTopLeftY;
-        if (relY >= 0 && relY < height && relX >= 0 && relX < width) {
-            std::string sym = "?";
-            if (obj.type == "CONTAINER") sym = "■";
-            else if (obj.type == "EXIT") sym = ">";
-            else if (obj.type == "BED") sym = "=";
-            display_grid[relY][relX] = sym;
-        }
+    const int layer = state.player.layerIndex;
+    const int maxX = clientTopLeftX + width - 1;
+    const int maxY = clientTopLeftY + height - 1;
+
+    visibleEntities.clear();
+    state.objectIndex.query(layer, clientTopLeftX, clientTopLeftY, maxX, maxY, visibleEntities);
+    for (const std::uint32_t i: visibleEntities) {
+        const auto &obj = state.objects[i];
+        GlyphId sym = OBJECT_UNKNOWN;
+        if (obj.type == "CONTAINER") sym = OBJECT_CONTAINER;
+        else if (obj.type == "EXIT") sym = OBJECT_EXIT;
+        else if (obj.type == "BED") sym = OBJECT_BED;
+        place(obj.x - clientTopLeftX, obj.y - clientTopLeftY, sym);
     }
 
-    for (const auto &npc: state.npcs) {
-        if (npc.z != state.player.layerIndex) continue;
-
-        const int relX = npc.x - clientTopLeftX;
-        const int relY = npc.y - clientTopLeftY;
-        if (relY >= 0 && relY < height && relX >= 0 && relX < width) {
-            std::string symbol = "E";
-            if (!npc.name.empty()) {
-                if (npc.aggressive) {
-                    symbol = "M";
-                } else {
-                    if (npc.interaction == "TRADE") symbol = "T";
-                    else if (npc.interaction == "HEAL") symbol = "H";
-                    else symbol = "N";
-                }
+    visibleEntities.clear();
+    state.npcIndex.query(layer, clientTopLeftX, clientTopLeftY, maxX, maxY, visibleEntities);
+    for (const std::uint32_t i: visibleEntities) {
+        const auto &npc = state.npcs[i];
+        GlyphId symbol = NPC_UNNAMED;
+        if (!npc.name.empty()) {
+            if (npc.aggressive) {
+                symbol = NPC_MONSTER;
+            } else {
+                if (npc.interaction == "TRADE") symbol = NPC_TRADER;
+                else if (npc.interaction == "HEAL") symbol = NPC_HEALER;
+                else symbol = NPC_OTHER;
             }
-            display_grid[relY][relX] = symbol;
         }
+        place(npc.x - clientTopLeftX, npc.y - clientTopLeftY, symbol);
     }
 
-    for (const auto &other : state.otherPlayers) {
-        if (other.z != state.player.layerIndex) continue;
-        const int relX = other.x - clientTopLeftX;
-        const int relY = other.y - clientTopLeftY;
-        if (relY >= 0 && relY < height && relX >= 0 && relX < width) {
-            display_grid[relY][relX] = "P";
-        }
+    visibleEntities.clear();
+    state.otherPlayerIndex.query(layer, clientTopLeftX, clientTopLeftY, maxX, maxY, visibleEntities);
+    for (const std::uint32_t i: visibleEntities) {
+        const auto &other = state.otherPlayers[i];
+        place(other.x - clientTopLeftX, other.y - clientTopLeftY, OTHER_PLAYER);
     }
 
-    int pRelX = state.player.x - clientTopLeftX;
-    int pRelY = state.player.y - clientTopLeftY;
-    if (pRelY >= 0 && pRelY < height && pRelX >= 0 && pRelX < width) {
-        display_grid[pRelY][pRelX] = "@";
-    }
+    place(state.player.x - clientTopLeftX, state.player.y - clientTopLeftY, SELF);
 
+    updateGlyphStyles(state.glyphs);
+    const auto styleOf = [&](const GlyphId id) {
+        return id >= GlyphTable::ReservedBase
+                   ? styleOfGlyph(OverlaySymbols[id - GlyphTable::ReservedBase])
+                   : static_cast<CellStyle>(glyphStyles[id]);
+    };
+    const auto textOf = [&](const GlyphId id) -> const std::string & {
+        return id >= GlyphTable::ReservedBase ? OverlaySymbols[id - GlyphTable::ReservedBase] : state.glyphs.glyph(id);
+    };
+
+    // Neighbouring cells with the same decoration share one text element.
     Elements rows_elements;
-    for (const auto &row_vec : display_grid) {
+    std::string run;
+    for (int y = 0; y < height; ++y) {
+        const GlyphId *cells = &mapCells[static_cast<std::size_t>(y) * width];
         Elements line_elems;
-        for (const auto &cell : row_vec) {
-            auto t = text(cell);
-            if (cell == "@") t = t | color(Color::GreenLight) | bold;
-            else if (cell == "P") t |= color(Color::BlueLight) | bold;
-            else if (cell == "M") t |=  color(Color::Red) | bold;
-            else if (cell == "N") t |= color(Color::Green) | bold;
-            else if (cell == "T") t |= color(Color::Gold1) | bold;
-            else if (cell == "H") t |= color(Color::Magenta1) | bold;
-            else if (cell == "■") t |= color(Color::Yellow);
-            else if (cell == ">") t |= color(Color::Green);
-            else if (cell == "=") t |= color(Color::Cyan);
-            else if (cell == "#" || cell == "┌" || cell == "┐" || cell == "└" || cell == "┘" || cell == "─" || cell == "│") t |= color(Color::Cyan);
-            else if (cell == ".") t |= color(Color::GrayDark);
-
-            line_elems.push_back(t);
+        for (int x = 0; x < width;) {
+            const CellStyle style = styleOf(cells[x]);
+            run.clear();
+            for (; x < width && styleOf(cells[x]) == style; ++x) {
+                run += textOf(cells[x]);
+            }
+            line_elems.push_back(styled(text(run), style));
         }
         rows_elements.push_back(hbox(line_elems));
     }
@@ -338,6 +417,17 @@ Element TuiRenderer::buildMap(const GameState &state) {
     });
 }
 
+void TuiRenderer::updateGlyphStyles(const GlyphTable &glyphs) {
+    // A smaller table belongs to another game state, e.g. in the benchmarks.
+    if (glyphs.size() < glyphStyles.size()) {
+        glyphStyles.clear();
+    }
+    while (glyphStyles.size() < glyphs.size()) {
+        const auto id = static_cast<GlyphId>(glyphStyles.size());
+        glyphStyles.push_back(static_cast<std::uint8_t>(styleOfGlyph(glyphs.glyph(id))));
+    }
+}
+
 Element TuiRenderer::buildStats(const dto::PlayerDto &player) {
     const float hp_perc = (player.maxHp > 0) ? static_cast<float>(player.hp) / static_cast<float>(player.maxHp) : 0.0f;
     const float rad_perc = std::clamp(static_cast<float>(player.rads) / 100.0f, 0.0f, 1.0f);
@@ -361,7 +451,7 @@ Element TuiRenderer::buildStats(const dto::PlayerDto &player) {
     }) | borderStyled(ROUNDED) | color(Color::Cyan) | size(HEIGHT, EQUAL, 3);
 }
 
-Element TuiRenderer::buildInventory(const GameState &state) {
+Element TuiRenderer::buildInventory(const GameView &state) {
     const auto& inventory = state.player.inventory;
     Elements items;
     int idx = 0;
@@ -388,7 +478,7 @@ Element TuiRenderer::buildInventory(const GameState &state) {
         | size(WIDTH, EQUAL, InventoryWidth) | size(HEIGHT, EQUAL, InventoryHeight) | borderStyled(ROUNDED) | color(Color::Cyan);
 }
 
-Element TuiRenderer::buildMetroUi(const GameState &state) {
+Element TuiRenderer::buildMetroUi(const GameView &state) {
     Elements stations;
     int idx = 0;
     for (const auto &station: state.metroUi.stations) {
@@ -412,7 +502,7 @@ Element TuiRenderer::buildMetroUi(const GameState &state) {
         | size(WIDTH, EQUAL, MetroWidth) | borderStyled(ROUNDED) | color(lineColor);
 }
 
-Element TuiRenderer::buildTradeUi(const GameState &state) {
+Element TuiRenderer::buildTradeUi(const GameView &state) {
     const auto& tradeOffer = state.tradeUi;
     Elements items;
 
@@ -489,12 +579,13 @@ Element TuiRenderer::buildHelp() {
         separator(),
         section_title(" SYSTEM "),
         key_row("L", "Toggle Logs"),
+        key_row("PGUP/DN", "Scroll Logs (HOME/END: Oldest/Newest)"),
         key_row("H", "Close Help"),
         key_row("ESC", "System Menu / Back")
     })) | size(WIDTH, EQUAL, HelpWidth) | borderStyled(ROUNDED) | color(Color::White);
 }
 
-Element TuiRenderer::buildMenu(const GameState &state) {
+Element TuiRenderer::buildMenu(const GameView &state) {
     auto option = [&](const std::string& label, const int index) {
         if (state.menuSelectionIndex == index) {
             return text(" > " + label + " < ") | bold | color(Color::Black) | bgcolor(Color::Green);
@@ -509,7 +600,7 @@ Element TuiRenderer::buildMenu(const GameState &state) {
     })) | size(WIDTH, EQUAL, MenuWidth) | borderStyled(ROUNDED) | color(Color::Green);
 }
 
-Element TuiRenderer::buildPayDebtUi(const GameState &state) {
+Element TuiRenderer::buildPayDebtUi(const GameView &state) {
     return window(text(" DEBT REPAYMENT ") | hcenter | bold, vbox({
         text("Current Debt: " + std::to_string(state.player.debt) + " CR") | color(Color::Red),
         separator(),
@@ -520,7 +611,7 @@ Element TuiRenderer::buildPayDebtUi(const GameState &state) {
     })) | size(WIDTH, EQUAL, PayDebtWidth) | borderStyled(ROUNDED) | color(Color::Magenta);
 }
 
-Element TuiRenderer::buildAnnouncement(const GameState &state) {
+Element TuiRenderer::buildAnnouncement(const GameView &state) {
     return window(text(" GLOBAL ANNOUNCEMENT ") | hcenter | bold | blink, vbox({
         paragraphAlignCenter(state.announcementMessage) | bold | color(Color::Yellow),
         separator(),
@@ -528,7 +619,7 @@ Element TuiRenderer::buildAnnouncement(const GameState &state) {
     })) | size(WIDTH, EQUAL, AnnouncementWidth) | borderStyled(ROUNDED) | color(Color::Red);
 }
 
-Element TuiRenderer::buildDialog(const GameState &state) {
+Element TuiRenderer::buildDialog(const GameView &state) {
     return window(text(" " + state.currentDialog.npcName + " ") | hcenter | bold, vbox({
         paragraphAlignCenter(state.currentDialog.text) | color(Color::White),
         separator(),
@@ -2,6 +2,9 @@
 #define TUIRENDERER_H
 
 #include "../game/GameState.h"
+#include "ScreenDiff.h"
+#include <cstdint>
+#include <vector>
 #include <ftxui/dom/elements.hpp>
 
 /**
@@ -17,25 +20,80 @@ public:
     ~TuiRenderer();
 
     /**
-     * @brief Renders the current game state to the terminal.
-     * @param state The current state of the game to render.
+     * @brief Renders a snapshot of the game state to the terminal.
+     *
+     * Skips the frame when the snapshot version and the terminal size are the same as
+     * for the last frame drawn. Takes no lock; the snapshot must not change while drawn.
+     * @param snapshot The latest snapshot published by the controller.
+     * @return True if a frame was drawn.
      */
-    void render(const GameState &state);
+    bool render(const RenderSnapshot &snapshot);
+
+    /** @brief Number of frames drawn to the terminal. */
+    [[nodiscard]] std::uint64_t getFramesRendered() const;
+
+    /** @brief Number of render calls skipped because nothing changed. */
+    [[nodiscard]] std::uint64_t getFramesSkipped() const;
+
+    /** @brief Total bytes of terminal output written by the drawn frames. */
+    [[nodiscard]] std::uint64_t getBytesWritten() const;
+
+    /**
+     * @brief Builds the whole window for the current state, as render() draws it.
+     * @param state The game state, not modified while the call runs.
+     * @return The window element.
+     */
+    ftxui::Element buildFrame(const GameView &state);
+
+    /**
+     * @brief Builds the map viewport with NPCs, objects and players drawn over it.
+     *
+     * Only indexes the decoded tile grid; decorations are looked up per glyph id and
+     * neighbouring cells with the same decoration are merged into one text element.
+     * @param state The game state, not modified while the call runs.
+     * @return The map element.
+     */
+    ftxui::Element buildMap(const GameView &state);
 
 private:
-    std::string last_reset_position;
+    /** @brief Writes only the cells that changed since the previous frame. */
+    ScreenDiff screenDiff;
+    /** @brief Terminal output of the current frame, reused across frames. */
+    std::string frameOutput;
+    std::uint64_t bytesWritten = 0;
+    /** @brief GameState version of the last frame drawn, 0 before the first frame. */
+    std::uint64_t renderedVersion = 0;
+    int renderedWidth = 0;
+    int renderedHeight = 0;
+    std::uint64_t framesRendered = 0;
+    std::uint64_t framesSkipped = 0;
+    /** @brief Scratch grid of the visible cells, reused across frames. */
+    std::vector<GlyphId> mapCells;
+    /** @brief Scratch list of the entities inside the viewport, reused across frames. */
+    std::vector<std::uint32_t> visibleEntities;
+    /**
+     * @brief Cached decoration of every glyph id.
+     *
+     * Glyph tables only grow and snapshots copy them, so ids keep their glyph across
+     * snapshots and the cache only has to be extended.
+     */
+    std::vector<std::uint8_t> glyphStyles;
+
+    /**
+     * @brief Classifies glyphs added to the table since the last frame.
+     */
+    void updateGlyphStyles(const GlyphTable &glyphs);
 
-    ftxui::Element buildLoginScreen(const GameState &state);
-    ftxui::Element buildMap(const GameState &state);
+    ftxui::Element buildLoginScreen(const GameView &state);
     ftxui::Element buildStats(const dto::PlayerDto &player);
-    ftxui::Element buildInventory(const GameState &state);
-    ftxui::Element buildMetroUi(const GameState &state);
-    ftxui::Element buildTradeUi(const GameState &state);
+    ftxui::Element buildInventory(const GameView &state);
+    ftxui::Element buildMetroUi(const GameView &state);
+    ftxui::Element buildTradeUi(const GameView &state);
     ftxui::Element buildHelp();
-    ftxui::Element buildMenu(const GameState &state);
-    ftxui::Element buildPayDebtUi(const GameState &state);
-    ftxui::Element buildAnnouncement(const GameState &state);
-    ftxui::Element buildDialog(const GameState &state);
+    ftxui::Element buildMenu(const GameView &state);
+    ftxui::Element buildPayDebtUi(const GameView &state);
+    ftxui::Element buildAnnouncement(const GameView &state);
+    ftxui::Element buildDialog(const GameView &state);
 };
 
 #endif //TUIRENDERER_H
@@ -0,0 +1,286 @@
+#ifndef DTOCODEC_H
+#define DTOCODEC_H
+
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../dto/GameRequests.h"
+#include "../dto/GameResponses.h"
+
+namespace utils {
+    /**
+     * @brief One member of a DTO as it appears on the wire.
+     * @tparam Fallback Type of the value used when the key is missing, null or of another type;
+     *         const char * for string members so the descriptors stay constexpr.
+     */
+    template<typename Dto, typename Member, typename Fallback>
+    struct Field {
+        std::string_view key;
+        Member Dto::*member;
+        Fallback fallback;
+    };
+
+    template<typename Dto, typename Member, typename Fallback>
+    constexpr Field<Dto, Member, Fallback> field(const std::string_view key, Member Dto::*member,
+                                                 const Fallback fallback) {
+        return {key, member, fallback};
+    }
+
+    /**
+     * @brief The wire fields of a DTO, one specialisation per DTO with a static constexpr tuple `fields`.
+     */
+    template<typename Dto>
+    struct DtoFields;
+
+    template<>
+    struct DtoFields<dto::ItemDto> {
+        static constexpr auto fields = std::make_tuple(
+            field("id", &dto::ItemDto::id, ""),
+            field("name", &dto::ItemDto::name, "Unknown"),
+            field("type", &dto::ItemDto::type, "MISC"),
+            field("description", &dto::ItemDto::description, ""),
+            field("rarity", &dto::ItemDto::rarity, "COMMON"),
+            field("quantity", &dto::ItemDto::quantity, 1),
+            field("price", &dto::ItemDto::price, 0));
+    };
+
+    template<>
+    struct DtoFields<dto::NpcDto> {
+        static constexpr auto fields = std::make_tuple(
+            field("id", &dto::NpcDto::id, ""),
+            field("name", &dto::NpcDto::name, ""),
+            field("type", &dto::NpcDto::type, ""),
+            field("x", &dto::NpcDto::x, 0),
+            field("y", &dto::NpcDto::y, 0),
+            field("z", &dto::NpcDto::z, 0),
+            field("hp", &dto::NpcDto::hp, 0),
+            field("maxHp", &dto::NpcDto::maxHp, 0),
+            field("aggressive", &dto::NpcDto::aggressive, false),
+            field("interaction", &dto::NpcDto::interaction, "TALK"));
+    };
+
+    template<>
+    struct DtoFields<dto::MapObjectDto> {
+        static constexpr auto fields = std::make_tuple(
+            field("id", &dto::MapObjectDto::id, ""),
+            field("type", &dto::MapObjectDto::type, ""),
+            field("x", &dto::MapObjectDto::x, 0),
+            field("y", &dto::MapObjectDto::y, 0),
+            field("z", &dto::MapObjectDto::z, 0),
+            field("action", &dto::MapObjectDto::action, ""),
+            field("description", &dto::MapObjectDto::description, ""));
+    };
+
+    template<>
+    struct DtoFields<dto::OtherPlayerDto> {
+        static constexpr auto fields = std::make_tuple(
+            field("id", &dto::OtherPlayerDto::id, ""),
+            field("name", &dto::OtherPlayerDto::name, "Unknown"),
+            field("x", &dto::OtherPlayerDto::x, 0),
+            field("y", &dto::OtherPlayerDto::y, 0),
+            field("z", &dto::OtherPlayerDto::z, 0));
+    };
+
+    template<>
+    struct DtoFields<dto::StationDto> {
+        static constexpr auto fields = std::make_tuple(
+            field("id", &dto::StationDto::id, ""),
+            field("name", &dto::StationDto::name, ""));
+    };
+
+    template<>
+    struct DtoFields<dto::TileChangeDto> {
+        static constexpr auto fields = std::make_tuple(
+            field("x", &dto::TileChangeDto::x, 0),
+            field("y", &dto::TileChangeDto::y, 0),
+            field("z", &dto::TileChangeDto::z, 0),
+            field("glyph", &dto::TileChangeDto::glyph, " "));
+    };
+
+    template<>
+    struct DtoFields<dto::DialogResponse> {
+        static constexpr auto fields = std::make_tuple(
+            field("npcName", &dto::DialogResponse::npcName, "Unknown"),
+            field("text", &dto::DialogResponse::text, ""));
+    };
+
+    template<>
+    struct DtoFields<dto::LoginRequest> {
+        static constexpr auto fields = std::make_tuple(
+            field("username", &dto::LoginRequest::username, ""),
+            field("playerClass", &dto::LoginRequest::playerClass, ""),
+            field("startingMapId", &dto::LoginRequest::startingMapId, ""));
+    };
+
+    template<>
+    struct DtoFields<dto::MoveRequest> {
+        static constexpr auto fields = std::make_tuple(field("direction", &dto::MoveRequest::direction, ""));
+    };
+
+    template<>
+    struct DtoFields<dto::ChatRequest> {
+        static constexpr auto fields = std::make_tuple(field("message", &dto::ChatRequest::message, ""));
+    };
+
+    template<>
+    struct DtoFields<dto::AttackRequest> {
+        static constexpr auto fields = std::make_tuple();
+    };
+
+    template<>
+    struct DtoFields<dto::InteractRequest> {
+        static constexpr auto fields = std::make_tuple();
+    };
+
+    template<>
+    struct DtoFields<dto::UseRequest> {
+        static constexpr auto fields = std::make_tuple(field("slotIndex", &dto::UseRequest::slotIndex, 0));
+    };
+
+    template<>
+    struct DtoFields<dto::EquipRequest> {
+        static constexpr auto fields = std::make_tuple(field("slotIndex", &dto::EquipRequest::slotIndex, 0));
+    };
+
+    template<>
+    struct DtoFields<dto::DropRequest> {
+        static constexpr auto fields = std::make_tuple(
+            field("slotIndex", &dto::DropRequest::slotIndex, 0),
+            field("amount", &dto::DropRequest::amount, 0));
+    };
+
+    template<>
+    struct DtoFields<dto::BuyRequest> {
+        static constexpr auto fields = std::make_tuple(
+            field("npcId", &dto::BuyRequest::npcId, ""),
+            field("itemIndex", &dto::BuyRequest::itemIndex, 0));
+    };
+
+    template<>
+    struct DtoFields<dto::SellRequest> {
+        static constexpr auto fields = std::make_tuple(
+            field("npcId", &dto::SellRequest::npcId, ""),
+            field("slotIndex", &dto::SellRequest::slotIndex, 0));
+    };
+
+    template<>
+    struct DtoFields<dto::TravelRequest> {
+        static constexpr auto fields = std::make_tuple(
+            field("mapId", &dto::TravelRequest::mapId, ""),
+            field("lineId", &dto::TravelRequest::lineId, ""));
+    };
+
+    template<>
+    struct DtoFields<dto::PayDebtRequest> {
+        static constexpr auto fields = std::make_tuple(field("amount", &dto::PayDebtRequest::amount, 0));
+    };
+
+    /**
+     * @brief Decodes and encodes the DTOs described by DtoFields.
+     *
+     * Decoding walks the members of the JSON object once and matches each key against
+     * the field list, instead of looking every field up in the object (three lookups
+     * and a temporary key string per field with JsonParser::safeString). Unknown keys
+     * are skipped; missing, null and mistyped values leave the fallback in place.
+     */
+    class DtoCodec {
+    public:
+        using json = nlohmann::json;
+
+        /**
+         * @brief Sets every described member of a DTO to its fallback.
+         *
+         * String members are assigned, not replaced, so they keep their buffers; the
+         * decoders rely on this when they refill DTOs taken from a DtoPool.
+         */
+        template<typename Dto>
+        static void reset(Dto &dto) {
+            std::apply([&dto](const auto &... f) { ((dto.*f.member = f.fallback), ...); }, DtoFields<Dto>::fields);
+        }
+
+        /**
+         * @brief Decodes a JSON object; anything else gives a DTO holding the fallbacks.
+         * @tparam Json nlohmann::json or another basic_json, such as the FrameJson of a received frame.
+         */
+        template<typename Dto, typename Json>
+        static Dto decode(const Json &j) {
+            Dto dto{};
+            reset(dto);
+            if (!j.is_object()) {
+                return dto;
+            }
+            for (auto it = j.begin(); it != j.end(); ++it) {
+                const std::string &key = it.key();
+                std::apply([&](const auto &... f) {
+                    (void) ((key == f.key && (read(it.value(), dto.*f.member), true)) || ...);
+                }, DtoFields<Dto>::fields);
+            }
+            return dto;
+        }
+
+        /**
+         * @brief Decodes every non-null element of a JSON array; anything else gives an empty vector.
+         */
+        template<typename Dto, typename Json>
+        static std::vector<Dto> decodeList(const Json &j) {
+            std::vector<Dto> list;
+            if (!j.is_array()) {
+                return list;
+            }
+            list.reserve(j.size());
+            for (const auto &element: j) {
+                if (!element.is_null()) {
+                    list.push_back(decode<Dto>(element));
+                }
+            }
+            return list;
+        }
+
+        /**
+         * @brief Encodes the described fields of a DTO as a JSON object.
+         */
+        template<typename Dto>
+        static json encode(const Dto &dto) {
+            json j = json::object();
+            std::apply([&](const auto &... f) { ((j[std::string(f.key)] = dto.*f.member), ...); },
+                       DtoFields<Dto>::fields);
+            return j;
+        }
+
+        /**
+         * @brief Encodes a request as the envelope the server expects: {"type": ..., "payload": {...}}.
+         */
+        template<typename Request>
+        static json encodeRequest(const Request &request) {
+            json envelope;
+            envelope["type"] = request.getType();
+            envelope["payload"] = encode(request);
+            return envelope;
+        }
+
+    private:
+        template<typename Json>
+        static void read(const Json &value, std::string &out) {
+            if (value.is_string()) out = value.template get_ref<const std::string &>();
+        }
+
+        template<typename Json>
+        static void read(const Json &value, int &out) {
+            if (value.is_number()) out = value.template get<int>();
+        }
+
+        template<typename Json>
+        static void read(const Json &value, long &out) {
+            if (value.is_number()) out = value.template get<long>();
+        }
+
+        template<typename Json>
+        static void read(const Json &value, bool &out) {
+            if (value.is_boolean()) out = value.template get<bool>();
+        }
+    };
+}
+
+#endif //DTOCODEC_H
@@ -0,0 +1,97 @@
+#ifndef DTOPOOL_H
+#define DTOPOOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace utils {
+    /**
+     * @brief Counters of one DtoPool.
+     */
+    struct DtoPoolStats {
+        uint64_t taken = 0;    ///< Lists the decoder asked for.
+        uint64_t reused = 0;   ///< Of those, lists that came from the pool with their elements.
+        uint64_t returned = 0; ///< Lists given back by GameState.
+    };
+
+    /**
+     * @brief Spare entity lists, handed from GameState back to the decoder so their strings get reused.
+     *
+     * NPC and player lists arrive several times a second and mostly carry the same
+     * entities again. GameState gives the list it replaces to the pool instead of
+     * freeing it; the decoder takes it, overwrites its elements in place and only
+     * grows it when the new list is longer. Assigning to a std::string keeps its buffer
+     * when the new value fits, so ids and names longer than the small-string buffer
+     * stop costing an allocation and a free on every update.
+     *
+     * Lists cross from the main thread to the network thread, so the spares sit behind
+     * a mutex; it is taken once per list, not per element.
+     *
+     * @tparam List A std::vector of DTOs.
+     */
+    template<typename List>
+    class DtoPool {
+    public:
+        /**
+         * @brief Returns a spare list, or an empty one. Its elements hold stale values; overwrite them.
+         */
+        static List take() {
+            Storage &storage = getStorage();
+            storage.taken.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(storage.mutex);
+            if (storage.spares.empty()) {
+                return {};
+            }
+            List list = std::move(storage.spares.back());
+            storage.spares.pop_back();
+            storage.reused.fetch_add(1, std::memory_order_relaxed);
+            return list;
+        }
+
+        /**
+         * @brief Keeps a list that is no longer needed for a later take(); dropped if the pool is full.
+         */
+        static void give(List list) {
+            if (list.empty()) {
+                return;
+            }
+            Storage &storage = getStorage();
+            storage.returned.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(storage.mutex);
+            if (storage.spares.size() < MaxSpares) {
+                storage.spares.push_back(std::move(list));
+            }
+        }
+
+        static DtoPoolStats getStats() {
+            const Storage &storage = getStorage();
+            DtoPoolStats stats;
+            stats.taken = storage.taken.load(std::memory_order_relaxed);
+            stats.reused = storage.reused.load(std::memory_order_relaxed);
+            stats.returned = storage.returned.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        /** @brief One list in flight plus one waiting covers a steady stream of updates. */
+        static constexpr std::size_t MaxSpares = 2;
+
+        struct Storage {
+            std::mutex mutex;
+            std::vector<List> spares;
+            std::atomic<uint64_t> taken{0};
+            std::atomic<uint64_t> reused{0};
+            std::atomic<uint64_t> returned{0};
+        };
+
+        static Storage &getStorage() {
+            static Storage storage;
+            return storage;
+        }
+    };
+}
+
+#endif //DTOPOOL_H
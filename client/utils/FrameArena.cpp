@@ -0,0 +1,124 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+
+namespace {
+    constexpr std::size_t FirstBlockSize = 64 * 1024;
+    /** @brief An arena grown past this by one huge frame gives its memory back instead of keeping it. */
+    constexpr std::size_t MaxRetainedBytes = 8 * 1024 * 1024;
+
+    struct Block {
+        std::unique_ptr<unsigned char[]> memory;
+        std::size_t size = 0;
+    };
+
+    /** @brief The arena of one thread. Counters are local and added to the totals once per frame. */
+    struct ThreadArena {
+        std::vector<Block> blocks;
+        std::size_t current = 0;
+        std::size_t used = 0;
+        int depth = 0;
+        uint64_t frameBytes = 0;
+        uint64_t allocations = 0;
+        uint64_t blockAllocations = 0;
+
+        [[nodiscard]] bool owns(const void *pointer) const {
+            const auto *p = static_cast<const unsigned char *>(pointer);
+            for (const auto &block: blocks) {
+                if (p >= block.memory.get() && p < block.memory.get() + block.size) return true;
+            }
+            return false;
+        }
+
+        void addBlock(const std::size_t minimum) {
+            const std::size_t size = std::max({FirstBlockSize, blocks.empty() ? 0 : blocks.back().size * 2, minimum});
+            blocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+            current = blocks.size() - 1;
+            used = 0;
+            ++blockAllocations;
+        }
+
+        void reset() {
+            std::size_t total = 0;
+            for (const auto &block: blocks) total += block.size;
+            if (total > MaxRetainedBytes) {
+                blocks.clear();
+            } else if (blocks.size() > 1) {
+                blocks.clear();
+                addBlock(total);
+            }
+            current = 0;
+            used = 0;
+        }
+    };
+
+    thread_local ThreadArena arena;
+
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> fallbacks{0};
+    std::atomic<uint64_t> blockAllocations{0};
+    std::atomic<uint64_t> peakFrameBytes{0};
+}
+
+namespace utils {
+    FrameArena::Scope::Scope() {
+        ++arena.depth;
+    }
+
+    FrameArena::Scope::~Scope() {
+        if (--arena.depth > 0) {
+            return;
+        }
+        arena.reset();
+        frames.fetch_add(1, std::memory_order_relaxed);
+        allocations.fetch_add(arena.allocations, std::memory_order_relaxed);
+        blockAllocations.fetch_add(arena.blockAllocations, std::memory_order_relaxed);
+        uint64_t peak = peakFrameBytes.load(std::memory_order_relaxed);
+        while (arena.frameBytes > peak
+               && !peakFrameBytes.compare_exchange_weak(peak, arena.frameBytes, std::memory_order_relaxed)) {}
+        arena.frameBytes = 0;
+        arena.allocations = 0;
+        arena.blockAllocations = 0;
+    }
+
+    void *FrameArena::allocate(const std::size_t bytes, const std::size_t alignment) {
+        if (arena.depth == 0) {
+            fallbacks.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(bytes);
+        }
+        ++arena.allocations;
+        arena.frameBytes += bytes;
+        while (true) {
+            if (arena.current < arena.blocks.size()) {
+                Block &block = arena.blocks[arena.current];
+                const auto base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+                const std::size_t offset = ((base + arena.used + alignment - 1) & ~(alignment - 1)) - base;
+                if (offset + bytes <= block.size) {
+                    arena.used = offset + bytes;
+                    return block.memory.get() + offset;
+                }
+            }
+            arena.addBlock(bytes + alignment);
+        }
+    }
+
+    void FrameArena::deallocate(void *pointer, std::size_t) noexcept {
+        if (!arena.owns(pointer)) {
+            ::operator delete(pointer);
+        }
+    }
+
+    FrameArenaStats FrameArena::getStats() {
+        FrameArenaStats stats;
+        stats.frames = frames.load(std::memory_order_relaxed);
+        stats.allocations = allocations.load(std::memory_order_relaxed);
+        stats.fallbacks = fallbacks.load(std::memory_order_relaxed);
+        stats.blockAllocations = blockAllocations.load(std::memory_order_relaxed);
+        stats.peakFrameBytes = peakFrameBytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+}
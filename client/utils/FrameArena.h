@@ -0,0 +1,102 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace utils {
+    /**
+     * @brief Counters of the frame arenas of all threads, summed.
+     */
+    struct FrameArenaStats {
+        uint64_t frames = 0;           ///< Outermost scopes closed, i.e. frames decoded with an arena.
+        uint64_t allocations = 0;      ///< Allocations served by bumping a pointer.
+        uint64_t fallbacks = 0;        ///< FrameAllocator calls made outside a scope, sent to the heap.
+        uint64_t blockAllocations = 0; ///< Blocks the arenas took from the heap.
+        uint64_t peakFrameBytes = 0;   ///< Most bytes a single frame used.
+    };
+
+    /**
+     * @brief Per-thread monotonic arena for the DOM of one decoded frame.
+     *
+     * While a Scope is open on a thread, allocate() bumps a pointer through a block of
+     * that thread's arena and deallocate() does nothing; the whole frame is dropped at
+     * once when the outermost Scope closes. If a frame needed more than one block, the
+     * blocks are replaced by a single one of their combined size, so the arena settles
+     * on the largest frame seen and later frames take nothing from the heap.
+     *
+     * Memory handed out inside a Scope must not outlive it or leave the thread. Outside
+     * a Scope, allocate() falls back to operator new, so FrameJson values built
+     * elsewhere (tests, benchmarks) behave like ordinary ones.
+     */
+    class FrameArena {
+    public:
+        /**
+         * @brief Opens the arena of the current thread; nested scopes share the outermost one.
+         */
+        class Scope {
+        public:
+            Scope();
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+        };
+
+        static void *allocate(std::size_t bytes, std::size_t alignment);
+
+        /**
+         * @brief Frees memory from allocate(); a no-op for memory inside the current thread's arena.
+         */
+        static void deallocate(void *pointer, std::size_t bytes) noexcept;
+
+        static FrameArenaStats getStats();
+    };
+
+    /**
+     * @brief Stateless allocator over FrameArena, for containers that live within one frame.
+     */
+    template<typename T>
+    struct FrameAllocator {
+        using value_type = T;
+
+        FrameAllocator() = default;
+
+        template<typename U>
+        FrameAllocator(const FrameAllocator<U> &) noexcept {}
+
+        T *allocate(const std::size_t count) {
+            return static_cast<T *>(FrameArena::allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *pointer, const std::size_t count) noexcept {
+            FrameArena::deallocate(pointer, count * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(const FrameAllocator<U> &) const noexcept {
+            return true;
+        }
+
+        template<typename U>
+        bool operator!=(const FrameAllocator<U> &) const noexcept {
+            return false;
+        }
+    };
+
+    /**
+     * @brief The DOM of a received frame: nlohmann::json with its objects, arrays and
+     *        string nodes in the frame arena.
+     *
+     * String contents keep std::string so JsonParser can hand them to the DTOs as they
+     * are; keys and values of the protocol mostly fit the small-string buffer anyway.
+     */
+    using FrameJson = nlohmann::basic_json<std::map, std::vector, std::string, bool, std::int64_t,
+        std::uint64_t, double, FrameAllocator>;
+}
+
+#endif //FRAMEARENA_H
@@ -3,16 +3,20 @@
 
 #include <nlohmann/json.hpp>
 #include "../dto/GameResponses.h"
+#include "DtoCodec.h"
+#include "FrameArena.h"
+#include "../event/EventType.h"
 #include <string>
 #include <vector>
 
 namespace utils {
-    using json = nlohmann::json;
+    /** @brief The DOM JsonParser reads; parseEvent builds it inside a FrameArena::Scope. */
+    using json = FrameJson;
 
     /**
      * @brief Utility class for parsing JSON data into DTO structures.
      *
-     * This class provides static methods to safely extract data from nlohmann::json objects
+     * This class provides static methods to safely extract data from FrameJson objects
      * and populate the Data Transfer Objects (DTOs) defined in GameResponses.h.
      * It handles missing keys and type mismatches gracefully by providing default values.
      */
@@ -67,15 +71,7 @@ namespace utils {
          */
         static dto::ItemDto parseItem(const json &j) {
             if (j.is_null()) return {};
-            dto::ItemDto item;
-            item.id = safeString(j, "id", "");
-            item.name = safeString(j, "name", "Unknown");
-            item.type = safeString(j, "type", "MISC");
-            item.description = safeString(j, "description", "");
-            item.rarity = safeString(j, "rarity", "COMMON");
-            item.quantity = safeInt(j, "quantity", 1);
-            item.price = safeInt(j, "price", 0);
-            return item;
+            return DtoCodec::decode<dto::ItemDto>(j);
         }
 
         /**
@@ -103,6 +99,25 @@ namespace utils {
             return m;
         }
 
+        /**
+         * @brief Parses a JSON object into a MapDeltaResponse.
+         * @param j The JSON object representing the map delta.
+         * @return A populated MapDeltaResponse.
+         */
+        static dto::MapDeltaResponse parseMapDelta(const json &j) {
+            dto::MapDeltaResponse d;
+            d.baseX = safeInt(j, "baseX", 0);
+            d.baseY = safeInt(j, "baseY", 0);
+            d.centerX = safeInt(j, "centerX", d.baseX);
+            d.centerY = safeInt(j, "centerY", d.baseY);
+            d.rows = parseMapStrips(j, "rows", "y");
+            d.columns = parseMapStrips(j, "columns", "x");
+            if (j.contains("tiles") && j["tiles"].is_array()) {
+                d.tiles = DtoCodec::decodeList<dto::TileChangeDto>(j["tiles"]);
+            }
+            return d;
+        }
+
         /**
          * @brief Parses a JSON object into a LoginOptionsResponse.
          * @param j The JSON object representing login options.
@@ -125,32 +140,30 @@ namespace utils {
             return r;
         }
 
+        /**
+         * @brief Reads the optional "capabilities" string array of a server envelope.
+         * @param root The full JSON envelope.
+         * @return The advertised capabilities, empty if absent.
+         */
+        static std::vector<std::string> parseCapabilities(const json &root) {
+            std::vector<std::string> capabilities;
+            if (root.contains("capabilities") && root["capabilities"].is_array()) {
+                for (const auto &capability: root["capabilities"]) {
+                    if (capability.is_string()) {
+                        capabilities.push_back(capability.get<std::string>());
+                    }
+                }
+            }
+            return capabilities;
+        }
+
         /**
          * @brief Parses a JSON array into a vector of NpcDto.
          * @param j The JSON array representing NPCs.
          * @return A vector of populated NpcDto objects.
          */
         static std::vector<dto::NpcDto> parseNpcs(const json &j) {
-            std::vector<dto::NpcDto> npcs;
-            if (j.is_array()) {
-                for (const auto &npcJson: j) {
-                    if (!npcJson.is_null()) {
-                        npcs.push_back({
-                            safeString(npcJson, "id", ""),
-                            safeString(npcJson, "name", ""),
-                            safeString(npcJson, "type", ""),
-                            safeInt(npcJson, "x", 0),
-                            safeInt(npcJson, "y", 0),
-                            safeInt(npcJson, "z", 0),
-                            safeInt(npcJson, "hp", 0),
-                            safeInt(npcJson, "maxHp", 0),
-                            npcJson.value("aggressive", false),
-                            safeString(npcJson, "interaction", "TALK")
-                        });
-                    }
-                }
-            }
-            return npcs;
+            return DtoCodec::decodeList<dto::NpcDto>(j);
         }
 
         /**
@@ -159,50 +172,186 @@ namespace utils {
          * @return A vector of populated MapObjectDto objects.
          */
         static std::vector<dto::MapObjectDto> parseMapObjects(const json &j) {
-            std::vector<dto::MapObjectDto> objects;
-            if (j.is_array()) {
-                for (const auto &objJson : j) {
-                    if (!objJson.is_null()) {
-                        dto::MapObjectDto obj;
-                        obj.id = safeString(objJson, "id", "");
-                        obj.type = safeString(objJson, "type", "");
-                        obj.x = safeInt(objJson, "x", 0);
-                        obj.y = safeInt(objJson, "y", 0);
-                        obj.z = safeInt(objJson, "z", 0);
-                        obj.action = safeString(objJson, "action", "");
-                        obj.description = safeString(objJson, "description", "");
-                        objects.push_back(obj);
-                    }
-                }
-            }
-            return objects;
+            return DtoCodec::decodeList<dto::MapObjectDto>(j);
         }
 
         /**
          * @brief Parses a JSON array into a vector of OtherPlayerDto.
+         *
+         * The list still contains the local player; GameController filters it out
+         * because only the main thread knows the player's id.
          * @param j The JSON array representing other players.
-         * @param selfId The ID of the current player (to exclude from the list).
          * @return A vector of populated OtherPlayerDto objects.
          */
-        static std::vector<dto::OtherPlayerDto> parseOtherPlayers(const json &j, const std::string& selfId) {
-            std::vector<dto::OtherPlayerDto> players;
-            if (j.is_array()) {
-                for (const auto &pJson : j) {
-                    if (!pJson.is_null()) {
-                        std::string pid = safeString(pJson, "id", "");
-                        if (pid != selfId) {
-                            players.push_back({
-                                pid,
-                                safeString(pJson, "name", "Unknown"),
-                                safeInt(pJson, "x", 0),
-                                safeInt(pJson, "y", 0),
-                                safeInt(pJson, "z", 0)
-                            });
-                        }
+        static std::vector<dto::OtherPlayerDto> parseOtherPlayers(const json &j) {
+            return DtoCodec::decodeList<dto::OtherPlayerDto>(j);
+        }
+
+        /**
+         * @brief Parses a JSON object into a partial StatsUpdateResponse.
+         * @param j The JSON object representing player stats.
+         * @return A StatsUpdateResponse with only the present fields set.
+         */
+        static dto::StatsUpdateResponse parseStats(const json &j) {
+            dto::StatsUpdateResponse stats;
+            stats.hp = optionalInt(j, "hp");
+            stats.maxHp = optionalInt(j, "maxHp");
+            stats.rads = optionalInt(j, "rads");
+            stats.credits = optionalInt(j, "credits");
+            stats.debt = optionalInt(j, "debt");
+            if (j.contains("globalDebt") && j["globalDebt"].is_number()) {
+                stats.globalDebt = j["globalDebt"].get<long>();
+            }
+            stats.equippedWeaponSlot = optionalSlot(j, "equippedWeaponSlot");
+            stats.equippedMaskSlot = optionalSlot(j, "equippedMaskSlot");
+            return stats;
+        }
+
+        /**
+         * @brief Parses a JSON object into a partial PlayerPositionResponse.
+         * @param j The JSON object with x, y and z coordinates.
+         * @return A PlayerPositionResponse with only the present coordinates set.
+         */
+        static dto::PlayerPositionResponse parsePlayerPosition(const json &j) {
+            return {optionalInt(j, "x"), optionalInt(j, "y"), optionalInt(j, "z")};
+        }
+
+        /**
+         * @brief Parses a JSON object keyed by slot index into an InventoryUpdateResponse.
+         * @param j The JSON object representing the inventory slots.
+         * @return A populated InventoryUpdateResponse.
+         */
+        static dto::InventoryUpdateResponse parseInventory(const json &j) {
+            dto::InventoryUpdateResponse inventory;
+            if (j.is_object()) {
+                for (auto &[key, val]: j.items()) {
+                    if (!val.is_null()) {
+                        inventory.slots[std::stoi(key)] = parseItem(val);
                     }
                 }
             }
-            return players;
+            return inventory;
+        }
+
+        /**
+         * @brief Parses a JSON object into a MetroUiResponse.
+         * @param j The JSON object representing the metro line.
+         * @return A populated MetroUiResponse.
+         */
+        static dto::MetroUiResponse parseMetroUi(const json &j) {
+            dto::MetroUiResponse metro;
+            metro.lineId = safeString(j, "lineId", "");
+            if (j.contains("stations")) {
+                metro.stations = DtoCodec::decodeList<dto::StationDto>(j["stations"]);
+            }
+            return metro;
+        }
+
+        /**
+         * @brief Parses a JSON object into a TradeUiLoadResponse.
+         * @param j The JSON object representing the trader's offer.
+         * @return A populated TradeUiLoadResponse.
+         */
+        static dto::TradeUiLoadResponse parseTradeUi(const json &j) {
+            dto::TradeUiLoadResponse trade;
+            trade.npcId = safeString(j, "npcId", "");
+            trade.npcName = safeString(j, "npcName", "");
+            if (j.contains("items")) {
+                trade.items = DtoCodec::decodeList<dto::ItemDto>(j["items"]);
+            }
+            return trade;
+        }
+
+        /**
+         * @brief Parses a JSON object into a DialogResponse.
+         * @param j The JSON object representing the dialog.
+         * @return A populated DialogResponse.
+         */
+        static dto::DialogResponse parseDialog(const json &j) {
+            return DtoCodec::decode<dto::DialogResponse>(j);
+        }
+
+        /**
+         * @brief Decodes the payload of a server envelope into the matching DTO.
+         *
+         * Runs on the network thread so the main thread only has to apply the result.
+         * @param type The event type resolved from the envelope.
+         * @param root The full JSON envelope ({"type": ..., "payload": ...}).
+         * @return The decoded message, StatusResponse for unusable envelopes, or
+         *         std::monostate when there is nothing to apply.
+         */
+        static dto::ServerMessage parseServerMessage(const EventType type, const json &root) {
+            if (!root.contains("payload")) {
+                return dto::StatusResponse{"Missing payload for: " + safeString(root, "type", "???")};
+            }
+            if (type == EventType::UNKNOWN) {
+                return dto::StatusResponse{"Unknown Event: " + safeString(root, "type", "???")};
+            }
+
+            const auto &data = root["payload"];
+            if (data.is_null()) {
+                return std::monostate{};
+            }
+
+            switch (type) {
+                case EventType::SEND_STATS: return parseStats(data);
+                case EventType::SEND_INVENTORY: return parseInventory(data);
+                case EventType::SEND_PLAYER_POSITION: return parsePlayerPosition(data);
+                case EventType::SEND_MAP_DATA: return parseMap(data);
+                case EventType::MAP_DELTA: return parseMapDelta(data);
+                case EventType::SEND_LOGIN_OPTIONS: {
+                    auto options = parseLoginOptions(data);
+                    options.capabilities = parseCapabilities(root);
+                    options.encoding = safeString(root, "encoding", "");
+                    return options;
+                }
+                case EventType::SEND_NPCS: return parseNpcs(data);
+                case EventType::SEND_MAP_OBJECTS: return parseMapObjects(data);
+                case EventType::BROADCAST_CHAT_MSG: return dto::ChatMessageResponse{safeString(data, "message", "")};
+                case EventType::OPEN_METRO_UI: return parseMetroUi(data);
+                case EventType::OPEN_TRADE_UI: return parseTradeUi(data);
+                case EventType::SEND_GAME_OVER: return dto::GameOverResponse{};
+                case EventType::SEND_MESSAGE:
+                case EventType::SEND_ERROR:
+                case EventType::GLOBAL_ANNOUNCEMENT:
+                    if (data.is_string()) return dto::TextMessageResponse{data.get<std::string>()};
+                    return std::monostate{};
+                case EventType::BROADCAST_PLAYERS: return parseOtherPlayers(data);
+                case EventType::DIALOG: return parseDialog(data);
+                default: return std::monostate{};
+            }
+        }
+
+    private:
+        static std::map<std::string, std::vector<dto::MapStripDto> > parseMapStrips(
+            const json &j, const std::string &key, const std::string &indexKey) {
+            std::map<std::string, std::vector<dto::MapStripDto> > layers;
+            if (!j.contains(key) || !j[key].is_object()) return layers;
+            for (auto &[layer, strips]: j[key].items()) {
+                if (!strips.is_array()) continue;
+                auto &target = layers[layer];
+                for (const auto &stripJson: strips) {
+                    if (stripJson.is_null()) continue;
+                    target.push_back({safeInt(stripJson, indexKey, 0), safeString(stripJson, "tiles", "")});
+                }
+            }
+            return layers;
+        }
+
+        static std::optional<int> optionalInt(const json &j, const std::string &key) {
+            if (j.contains(key) && j[key].is_number()) {
+                return j[key].get<int>();
+            }
+            return std::nullopt;
+        }
+
+        static std::optional<std::string> optionalSlot(const json &j, const std::string &key) {
+            if (!j.contains(key)) return std::nullopt;
+            const auto &slot = j[key];
+            if (slot.is_null()) return std::string();
+            if (slot.is_number()) return std::to_string(slot.get<int>());
+            if (slot.is_string()) return slot.get<std::string>();
+            return std::nullopt;
         }
     };
 }
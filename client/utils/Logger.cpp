@@ -0,0 +1,221 @@
+#include "Logger.h"
+#include "../event/MpscQueue.h"
+#include "../event/WakeSignal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t RingCapacity = 4096;
+    constexpr std::size_t MaxCategoryLength = 15;
+    constexpr std::chrono::milliseconds FlushInterval(100);
+    /** @brief stdio buffer of the log file, large enough for a full batch of records. */
+    constexpr std::size_t FileBufferSize = 256 * 1024;
+
+    struct LogRecord {
+        uint64_t micros = 0;
+        LogLevel level = LogLevel::DEBUG;
+        uint8_t categoryLength = 0;
+        uint16_t messageLength = 0;
+        char category[MaxCategoryLength];
+        char message[Logger::MaxMessageLength];
+    };
+
+    /** @brief Everything owned by a started logger. */
+    struct Sink {
+        MpscQueue<LogRecord, RingCapacity> ring;
+        WakeSignal wakeSignal;
+        std::atomic<bool> running{true};
+        std::thread writer;
+        std::FILE *file = nullptr;
+        std::unique_ptr<char[]> fileBuffer;
+        LogFormat format = LogFormat::TEXT;
+        Clock::time_point startTime;
+        /** @brief Dropped records already reported in the file. Writer only. */
+        uint64_t reportedDrops = 0;
+        std::string batch;
+    };
+
+    std::atomic<LogLevel> minLevel{LogLevel::OFF};
+    std::atomic<uint64_t> dropped{0};
+    /** @brief Set while started; producers only dereference it after passing the level check. */
+    std::atomic<Sink *> activeSink{nullptr};
+
+    char levelLetter(const LogLevel level) {
+        switch (level) {
+            case LogLevel::DEBUG: return 'D';
+            case LogLevel::INFO: return 'I';
+            case LogLevel::WARNING: return 'W';
+            case LogLevel::SEVERE: return 'S';
+            default: return '?';
+        }
+    }
+
+    void putLittleEndian(std::string &out, uint64_t value, const int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out += static_cast<char>(value & 0xFF);
+            value >>= 8;
+        }
+    }
+
+    void appendRecord(Sink &sink, const LogRecord &record) {
+        std::string &out = sink.batch;
+        if (sink.format == LogFormat::BINARY) {
+            putLittleEndian(out, record.micros, 8);
+            putLittleEndian(out, static_cast<uint8_t>(record.level), 1);
+            putLittleEndian(out, record.categoryLength, 1);
+            putLittleEndian(out, record.messageLength, 2);
+            out.append(record.category, record.categoryLength);
+            out.append(record.message, record.messageLength);
+            return;
+        }
+        char prefix[40];
+        const int length = std::snprintf(prefix, sizeof(prefix), "%llu.%06llu %c ",
+                                         static_cast<unsigned long long>(record.micros / 1000000),
+                                         static_cast<unsigned long long>(record.micros % 1000000),
+                                         levelLetter(record.level));
+        out.append(prefix, static_cast<std::size_t>(length));
+        out.append(record.category, record.categoryLength);
+        out += ' ';
+        out.append(record.message, record.messageLength);
+        out += '\n';
+    }
+
+    LogRecord makeRecord(const Sink &sink, const LogLevel level, const std::string_view category,
+                         const std::string_view message) {
+        LogRecord record;
+        record.micros = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - sink.startTime).count());
+        record.level = level;
+        record.categoryLength = static_cast<uint8_t>(std::min(category.size(), MaxCategoryLength));
+        std::memcpy(record.category, category.data(), record.categoryLength);
+        record.messageLength = static_cast<uint16_t>(std::min(message.size(), Logger::MaxMessageLength));
+        std::memcpy(record.message, message.data(), record.messageLength);
+        return record;
+    }
+
+    /** @brief Writes everything queued so far as one batch. Writer only. */
+    void drain(Sink &sink) {
+        sink.batch.clear();
+        LogRecord record;
+        while (sink.ring.tryPop(record)) {
+            appendRecord(sink, record);
+        }
+        const uint64_t drops = dropped.load(std::memory_order_relaxed);
+        if (drops != sink.reportedDrops) {
+            const std::string message = std::to_string(drops - sink.reportedDrops) + " records dropped, log ring full";
+            appendRecord(sink, makeRecord(sink, LogLevel::WARNING, "LOG", message));
+            sink.reportedDrops = drops;
+        }
+        if (!sink.batch.empty()) {
+            std::fwrite(sink.batch.data(), 1, sink.batch.size(), sink.file);
+            std::fflush(sink.file);
+        }
+    }
+
+    void runWriter(Sink &sink) {
+        while (sink.running.load(std::memory_order_acquire)) {
+            sink.wakeSignal.waitUntil(Clock::now() + FlushInterval);
+            drain(sink);
+        }
+        drain(sink);
+    }
+
+    void writeHeader(const Sink &sink) {
+        const std::time_t now = std::time(nullptr);
+        char wallClock[32] = "unknown";
+        if (const std::tm *local = std::localtime(&now)) {
+            std::strftime(wallClock, sizeof(wallClock), "%Y-%m-%d %H:%M:%S", local);
+        }
+        const char *magic = sink.format == LogFormat::BINARY ? "AFTLOG1" : "#";
+        std::fprintf(sink.file, "%s log started %s, timestamps count from here\n", magic, wallClock);
+    }
+}
+
+bool Logger::start(const LogConfig &config) {
+    stop();
+    if (config.level == LogLevel::OFF) {
+        return true;
+    }
+    auto sink = std::make_unique<Sink>();
+    sink->file = std::fopen(config.path.c_str(), config.format == LogFormat::BINARY ? "ab" : "a");
+    if (!sink->file) {
+        return false;
+    }
+    sink->fileBuffer = std::make_unique<char[]>(FileBufferSize);
+    std::setvbuf(sink->file, sink->fileBuffer.get(), _IOFBF, FileBufferSize);
+    sink->format = config.format;
+    sink->startTime = Clock::now();
+    sink->reportedDrops = dropped.load(std::memory_order_relaxed);
+    writeHeader(*sink);
+
+    Sink *raw = sink.release();
+    raw->writer = std::thread(runWriter, std::ref(*raw));
+    activeSink.store(raw, std::memory_order_release);
+    minLevel.store(config.level, std::memory_order_release);
+    return true;
+}
+
+void Logger::stop() {
+    Sink *sink = activeSink.exchange(nullptr, std::memory_order_acq_rel);
+    minLevel.store(LogLevel::OFF, std::memory_order_release);
+    if (!sink) {
+        return;
+    }
+    sink->running.store(false, std::memory_order_release);
+    sink->wakeSignal.notify();
+    sink->writer.join();
+    std::fclose(sink->file);
+    delete sink;
+}
+
+bool Logger::enabled(const LogLevel level) {
+    return level != LogLevel::OFF && level >= minLevel.load(std::memory_order_relaxed);
+}
+
+void Logger::log(const LogLevel level, const std::string_view category, const std::string_view message) {
+    if (!enabled(level)) {
+        return;
+    }
+    Sink *sink = activeSink.load(std::memory_order_acquire);
+    if (!sink) {
+        return;
+    }
+    if (!sink->ring.tryEnqueue(makeRecord(*sink, level, category, message))) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        sink->wakeSignal.notify();
+        return;
+    }
+    if (sink->ring.sizeApprox() >= RingCapacity / 2) {
+        sink->wakeSignal.notify();
+    }
+}
+
+uint64_t Logger::droppedRecords() {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+bool Logger::levelFromName(const std::string &name, LogLevel &level) {
+    static const std::pair<const char *, LogLevel> names[] = {
+        {"debug", LogLevel::DEBUG},
+        {"info", LogLevel::INFO},
+        {"warning", LogLevel::WARNING},
+        {"severe", LogLevel::SEVERE},
+        {"off", LogLevel::OFF},
+    };
+    for (const auto &[candidate, value]: names) {
+        if (name == candidate) {
+            level = value;
+            return true;
+        }
+    }
+    return false;
+}
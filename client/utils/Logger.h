@@ -0,0 +1,92 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Severity of a log record; records below the configured level are not recorded.
+ */
+enum class LogLevel : std::uint8_t {
+    DEBUG,
+    INFO,
+    WARNING,
+    SEVERE,
+    OFF ///< Only as a configured level: records nothing.
+};
+
+/**
+ * @brief On-disk layout of the log file.
+ */
+enum class LogFormat {
+    TEXT,  ///< One compact line per record: seconds since start, level letter, category, message.
+    BINARY ///< Length-prefixed records after an "AFTLOG1" header line, see Logger.
+};
+
+struct LogConfig {
+    std::string path = "client_debug.log";
+    LogLevel level = LogLevel::DEBUG;
+    LogFormat format = LogFormat::TEXT;
+};
+
+/**
+ * @brief Process-wide asynchronous logger.
+ *
+ * log() copies the record into a lock-free ring and returns; a background thread
+ * drains the ring every 100 ms, or earlier once it is half full, and writes the
+ * batch with one buffered write and one flush. Threads that log never touch the
+ * file. When the ring is full records are dropped and counted rather than making
+ * the caller wait; the count is written to the log.
+ *
+ * Timestamps are microseconds of a monotonic clock since start(). A binary record
+ * is: uint64 timestamp, uint8 level, uint8 category length, uint16 message length
+ * (all little-endian), then the category and message bytes.
+ *
+ * Until start() and after stop() every level is disabled and log() does nothing.
+ */
+class Logger {
+public:
+    /** @brief Longest message kept; longer ones are truncated. */
+    static constexpr std::size_t MaxMessageLength = 224;
+
+    /**
+     * @brief Opens the log file and starts the writer thread.
+     * @param config Where and what to log.
+     * @return False if the file could not be opened; logging stays disabled.
+     */
+    static bool start(const LogConfig &config);
+
+    /**
+     * @brief Writes all pending records, stops the writer thread and closes the file.
+     *
+     * Threads that may still be inside log() must have finished before this is called.
+     */
+    static void stop();
+
+    /**
+     * @brief Checks whether records of a level are recorded, so callers can skip building the message.
+     */
+    static bool enabled(LogLevel level);
+
+    /**
+     * @brief Records a message. Safe from any thread, never blocks.
+     * @param level The severity.
+     * @param category Short tag such as "MAP" or "EVENT"; at most 15 characters are kept.
+     * @param message The text; at most MaxMessageLength bytes are kept.
+     */
+    static void log(LogLevel level, std::string_view category, std::string_view message);
+
+    /**
+     * @brief Number of records dropped because the ring was full.
+     */
+    static std::uint64_t droppedRecords();
+
+    /**
+     * @brief Parses a level name as used on the command line ("debug", "info", "warning", "severe", "off").
+     * @return False if the name is unknown.
+     */
+    static bool levelFromName(const std::string &name, LogLevel &level);
+};
+
+#endif //LOGGER_H
@@ -0,0 +1,78 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A bounded history that keeps the newest items.
+ *
+ * Once full, each push overwrites the oldest item in place, so adding is O(1) and
+ * nothing is shifted. Storage grows on demand up to the capacity and never beyond.
+ * Not thread-safe; GameState guards it with its mutex.
+ *
+ * @tparam T The type of the items. Must be move-assignable.
+ */
+template<typename T>
+class RingBuffer {
+    std::vector<T> _items;
+    /** @brief Slot of the oldest item once the buffer is full, otherwise 0. */
+    std::size_t _first = 0;
+    std::size_t _capacity;
+
+public:
+    /**
+     * @param capacity Maximum number of items kept; at least one.
+     */
+    explicit RingBuffer(const std::size_t capacity) : _capacity(std::max<std::size_t>(1, capacity)) {}
+
+    /**
+     * @brief Appends an item, dropping the oldest one if the buffer is full.
+     */
+    void push(T item) {
+        if (_items.size() < _capacity) {
+            _items.push_back(std::move(item));
+            return;
+        }
+        _items[_first] = std::move(item);
+        _first = (_first + 1) % _capacity;
+    }
+
+    /**
+     * @brief Returns the item at a position counted from the oldest one.
+     * @param index 0 is the oldest item, size() - 1 the newest. Must be in range.
+     */
+    const T &operator[](const std::size_t index) const {
+        return _items[(_first + index) % _items.size()];
+    }
+
+    [[nodiscard]] std::size_t size() const { return _items.size(); }
+
+    [[nodiscard]] bool empty() const { return _items.empty(); }
+
+    [[nodiscard]] std::size_t capacity() const { return _capacity; }
+
+    /**
+     * @brief Changes the capacity, keeping the newest items that still fit.
+     */
+    void setCapacity(const std::size_t capacity) {
+        const std::size_t newCapacity = std::max<std::size_t>(1, capacity);
+        const std::size_t kept = std::min(_items.size(), newCapacity);
+        std::vector<T> items;
+        items.reserve(kept);
+        for (std::size_t i = _items.size() - kept; i < _items.size(); ++i) {
+            items.push_back(std::move(_items[(_first + i) % _items.size()]));
+        }
+        _items = std::move(items);
+        _first = 0;
+        _capacity = newCapacity;
+    }
+
+    void clear() {
+        _items.clear();
+        _first = 0;
+    }
+};
+
+#endif //RINGBUFFER_H
@@ -0,0 +1,527 @@
+#include "SaxDecoder.h"
+
+#include <cctype>
+#include <nlohmann/json.hpp>
+#include "DtoCodec.h"
+#include "DtoPool.h"
+
+namespace {
+    using json = nlohmann::json;
+
+    enum class Kind { POSITION, STATS, NPCS, PLAYERS };
+
+    enum class Field {
+        NONE, ID, NAME, TYPE, X, Y, Z, HP, MAX_HP, AGGRESSIVE, INTERACTION,
+        RADS, CREDITS, DEBT, GLOBAL_DEBT, WEAPON_SLOT, MASK_SLOT
+    };
+
+    /** @brief What the next value at envelope level belongs to. */
+    enum class Expect { NONE, TYPE_VALUE, PAYLOAD };
+
+    bool kindOf(const EventType type, Kind &kind) {
+        switch (type) {
+            case EventType::SEND_PLAYER_POSITION: kind = Kind::POSITION; return true;
+            case EventType::SEND_STATS: kind = Kind::STATS; return true;
+            case EventType::SEND_NPCS: kind = Kind::NPCS; return true;
+            case EventType::BROADCAST_PLAYERS: kind = Kind::PLAYERS; return true;
+            default: return false;
+        }
+    }
+
+    /**
+     * @brief nlohmann SAX consumer that decodes one hot envelope straight into its DTO.
+     *
+     * Depth 1 is the envelope object. Object payloads (position, stats) keep their fields
+     * at depth 2, list payloads (NPCs, players) keep element fields at depth 3. Anything
+     * nested deeper than the field level is skipped.
+     */
+    class HotMessageHandler {
+    public:
+        EventType type = EventType::UNKNOWN;
+
+        /**
+         * @brief Sets the type up front for envelopes whose payload precedes the type key.
+         * @return False if the type is not a hot one.
+         */
+        bool presetType(const std::string &name) {
+            return resolveType(name);
+        }
+
+        /**
+         * @brief Whether parsing stopped because the payload arrived before the type.
+         */
+        [[nodiscard]] bool needsType() const {
+            return payloadBeforeType;
+        }
+
+        bool null() {
+            if (depth == 1) {
+                if (expect == Expect::PAYLOAD) payloadIsNull = true;
+                return envelopeScalar();
+            }
+            if (isField() && (field == Field::WEAPON_SLOT || field == Field::MASK_SLOT)) {
+                slot() = std::string();
+            }
+            return true;
+        }
+
+        bool boolean(const bool val) {
+            if (depth == 1) return envelopeScalar();
+            if (isField() && field == Field::AGGRESSIVE && kind == Kind::NPCS) {
+                npcs[used - 1].aggressive = val;
+            }
+            return true;
+        }
+
+        bool number_integer(const json::number_integer_t val) {
+            if (depth == 1) return envelopeScalar();
+            if (isField()) onNumber(static_cast<long long>(val));
+            return true;
+        }
+
+        bool number_unsigned(const json::number_unsigned_t val) {
+            if (depth == 1) return envelopeScalar();
+            if (isField()) onNumber(static_cast<long long>(val));
+            return true;
+        }
+
+        bool number_float(const json::number_float_t val, const json::string_t &) {
+            if (depth == 1) return envelopeScalar();
+            if (isField()) onNumber(static_cast<long long>(val));
+            return true;
+        }
+
+        bool string(json::string_t &val) {
+            if (depth == 1) {
+                if (expect == Expect::TYPE_VALUE) {
+                    expect = Expect::NONE;
+                    return resolveType(val);
+                }
+                return envelopeScalar();
+            }
+            if (isField()) onString(val);
+            return true;
+        }
+
+        bool binary(json::binary_t &) {
+            if (depth == 1) return envelopeScalar();
+            return true;
+        }
+
+        bool start_object(std::size_t) {
+            if (depth == 1 && expect == Expect::PAYLOAD) {
+                expect = Expect::NONE;
+                inPayload = kind == Kind::POSITION || kind == Kind::STATS;
+            } else if (depth == 1 && expect == Expect::TYPE_VALUE) {
+                return false;
+            } else if (depth == 2 && inPayload && isList()) {
+                beginElement();
+            } else {
+                field = Field::NONE;
+            }
+            ++depth;
+            return true;
+        }
+
+        bool start_array(std::size_t) {
+            if (depth == 1 && expect == Expect::PAYLOAD) {
+                expect = Expect::NONE;
+                inPayload = isList();
+            } else if (depth == 1 && expect == Expect::TYPE_VALUE) {
+                return false;
+            } else {
+                field = Field::NONE;
+            }
+            ++depth;
+            return true;
+        }
+
+        bool key(json::string_t &val) {
+            if (depth == 1) {
+                if (val == "type") {
+                    expect = Expect::TYPE_VALUE;
+                } else if (val == "payload") {
+                    if (!typeKnown) {
+                        payloadBeforeType = true;
+                        return false;
+                    }
+                    expect = Expect::PAYLOAD;
+                    sawPayload = true;
+                } else {
+                    expect = Expect::NONE;
+                }
+            } else if (inPayload && depth == fieldDepth()) {
+                field = lookupField(val);
+            }
+            return true;
+        }
+
+        bool end_object() {
+            return leave();
+        }
+
+        bool end_array() {
+            return leave();
+        }
+
+        bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) {
+            return false;
+        }
+
+        /**
+         * @brief Moves the decoded result into the message once parsing finished.
+         * @return False if the envelope never named a hot type.
+         */
+        bool finish(dto::ServerMessage &message) {
+            if (!typeKnown) return false;
+            if (!sawPayload) {
+                message = dto::StatusResponse{"Missing payload for: " + typeName};
+            } else if (payloadIsNull) {
+                message = std::monostate{};
+            } else {
+                switch (kind) {
+                    case Kind::POSITION: message = std::move(position); break;
+                    case Kind::STATS: message = std::move(stats); break;
+                    case Kind::NPCS:
+                        npcs.erase(npcs.begin() + static_cast<std::ptrdiff_t>(used), npcs.end());
+                        message = std::move(npcs);
+                        break;
+                    case Kind::PLAYERS:
+                        players.erase(players.begin() + static_cast<std::ptrdiff_t>(used), players.end());
+                        message = std::move(players);
+                        break;
+                }
+            }
+            return true;
+        }
+
+    private:
+        int depth = 0;
+        Expect expect = Expect::NONE;
+        Kind kind = Kind::POSITION;
+        Field field = Field::NONE;
+        bool typeKnown = false;
+        bool sawPayload = false;
+        bool payloadIsNull = false;
+        bool inPayload = false;
+        bool payloadBeforeType = false;
+        std::string typeName;
+
+        dto::PlayerPositionResponse position;
+        dto::StatsUpdateResponse stats;
+        dto::NpcsUpdateResponse npcs;
+        dto::OtherPlayersUpdateResponse players;
+        /** @brief List elements decoded so far; elements past it are left over from a pooled list. */
+        std::size_t used = 0;
+
+        [[nodiscard]] bool isList() const {
+            return kind == Kind::NPCS || kind == Kind::PLAYERS;
+        }
+
+        [[nodiscard]] int fieldDepth() const {
+            return isList() ? 3 : 2;
+        }
+
+        [[nodiscard]] bool isField() const {
+            return inPayload && depth == fieldDepth() && field != Field::NONE;
+        }
+
+        bool envelopeScalar() {
+            expect = Expect::NONE;
+            return true;
+        }
+
+        bool resolveType(const std::string &name) {
+            if (typeKnown) {
+                return name == typeName;
+            }
+            const EventType resolved = eventTypeFromName(name);
+            if (resolved == EventType::UNKNOWN || !kindOf(resolved, kind)) {
+                return false;
+            }
+            type = resolved;
+            typeName = name;
+            typeKnown = true;
+            return true;
+        }
+
+        bool leave() {
+            --depth;
+            if (depth == 1) {
+                inPayload = false;
+            }
+            field = Field::NONE;
+            return true;
+        }
+
+        void beginElement() {
+            if (kind == Kind::NPCS) {
+                nextElement(npcs);
+            } else {
+                nextElement(players);
+            }
+        }
+
+        /**
+         * @brief Starts the next list element, reusing one of a list taken from the DtoPool when there is one.
+         */
+        template<typename List>
+        void nextElement(List &list) {
+            if (used == 0) {
+                list = utils::DtoPool<List>::take();
+            }
+            if (used == list.size()) {
+                list.emplace_back();
+            }
+            utils::DtoCodec::reset(list[used++]);
+        }
+
+        Field lookupField(const std::string &key) const {
+            switch (kind) {
+                case Kind::POSITION:
+                    if (key == "x") return Field::X;
+                    if (key == "y") return Field::Y;
+                    if (key == "z") return Field::Z;
+                    break;
+                case Kind::STATS:
+                    if (key == "hp") return Field::HP;
+                    if (key == "maxHp") return Field::MAX_HP;
+                    if (key == "rads") return Field::RADS;
+                    if (key == "credits") return Field::CREDITS;
+                    if (key == "debt") return Field::DEBT;
+                    if (key == "globalDebt") return Field::GLOBAL_DEBT;
+                    if (key == "equippedWeaponSlot") return Field::WEAPON_SLOT;
+                    if (key == "equippedMaskSlot") return Field::MASK_SLOT;
+                    break;
+                case Kind::NPCS:
+                    if (key == "id") return Field::ID;
+                    if (key == "name") return Field::NAME;
+                    if (key == "type") return Field::TYPE;
+                    if (key == "x") return Field::X;
+                    if (key == "y") return Field::Y;
+                    if (key == "z") return Field::Z;
+                    if (key == "hp") return Field::HP;
+                    if (key == "maxHp") return Field::MAX_HP;
+                    if (key == "aggressive") return Field::AGGRESSIVE;
+                    if (key == "interaction") return Field::INTERACTION;
+                    break;
+                case Kind::PLAYERS:
+                    if (key == "id") return Field::ID;
+                    if (key == "name") return Field::NAME;
+                    if (key == "x") return Field::X;
+                    if (key == "y") return Field::Y;
+                    if (key == "z") return Field::Z;
+                    break;
+            }
+            return Field::NONE;
+        }
+
+        std::optional<std::string> &slot() {
+            return field == Field::WEAPON_SLOT ? stats.equippedWeaponSlot : stats.equippedMaskSlot;
+        }
+
+        void onNumber(const long long val) {
+            const int v = static_cast<int>(val);
+            switch (kind) {
+                case Kind::POSITION:
+                    if (field == Field::X) position.x = v;
+                    else if (field == Field::Y) position.y = v;
+                    else if (field == Field::Z) position.z = v;
+                    break;
+                case Kind::STATS:
+                    if (field == Field::HP) stats.hp = v;
+                    else if (field == Field::MAX_HP) stats.maxHp = v;
+                    else if (field == Field::RADS) stats.rads = v;
+                    else if (field == Field::CREDITS) stats.credits = v;
+                    else if (field == Field::DEBT) stats.debt = v;
+                    else if (field == Field::GLOBAL_DEBT) stats.globalDebt = static_cast<long>(val);
+                    else if (field == Field::WEAPON_SLOT || field == Field::MASK_SLOT) slot() = std::to_string(v);
+                    break;
+                case Kind::NPCS: {
+                    auto &npc = npcs[used - 1];
+                    if (field == Field::X) npc.x = v;
+                    else if (field == Field::Y) npc.y = v;
+                    else if (field == Field::Z) npc.z = v;
+                    else if (field == Field::HP) npc.hp = v;
+                    else if (field == Field::MAX_HP) npc.maxHp = v;
+                    break;
+                }
+                case Kind::PLAYERS: {
+                    auto &player = players[used - 1];
+                    if (field == Field::X) player.x = v;
+                    else if (field == Field::Y) player.y = v;
+                    else if (field == Field::Z) player.z = v;
+                    break;
+                }
+            }
+        }
+
+        /**
+         * @brief Stores a string field. List element strings are copied rather than moved: the
+         *        element usually comes from a pooled list whose buffer already fits, and the
+         *        parser keeps its token buffer.
+         */
+        void onString(std::string &val) {
+            switch (kind) {
+                case Kind::POSITION:
+                    break;
+                case Kind::STATS:
+                    if (field == Field::WEAPON_SLOT || field == Field::MASK_SLOT) slot() = std::move(val);
+                    break;
+                case Kind::NPCS: {
+                    auto &npc = npcs[used - 1];
+                    if (field == Field::ID) npc.id = val;
+                    else if (field == Field::NAME) npc.name = val;
+                    else if (field == Field::TYPE) npc.type = val;
+                    else if (field == Field::INTERACTION) npc.interaction = val;
+                    break;
+                }
+                case Kind::PLAYERS: {
+                    auto &player = players[used - 1];
+                    if (field == Field::ID) player.id = val;
+                    else if (field == Field::NAME) player.name = val;
+                    break;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief SAX consumer that only looks for the envelope's "type" value, for binary frames.
+     *
+     * Stops the parse as soon as the value is seen; everything else is ignored.
+     */
+    class TypePeekHandler {
+    public:
+        std::string name;
+
+        bool null() { return scalar(); }
+        bool boolean(bool) { return scalar(); }
+        bool number_integer(json::number_integer_t) { return scalar(); }
+        bool number_unsigned(json::number_unsigned_t) { return scalar(); }
+        bool number_float(json::number_float_t, const json::string_t &) { return scalar(); }
+        bool binary(json::binary_t &) { return scalar(); }
+
+        bool string(json::string_t &val) {
+            if (depth == 1 && expectType) {
+                name = std::move(val);
+                return false;
+            }
+            return scalar();
+        }
+
+        bool start_object(std::size_t) { return enter(); }
+        bool start_array(std::size_t) { return enter(); }
+        bool end_object() { --depth; return true; }
+        bool end_array() { --depth; return true; }
+
+        bool key(json::string_t &val) {
+            if (depth == 1) expectType = val == "type";
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) {
+            return false;
+        }
+
+    private:
+        int depth = 0;
+        bool expectType = false;
+
+        bool scalar() {
+            if (depth == 1 && expectType) return false;
+            return true;
+        }
+
+        bool enter() {
+            if (depth == 1 && expectType) return false;
+            ++depth;
+            return true;
+        }
+    };
+
+    /**
+     * @brief Finds the value of the top-level "type" key without parsing the frame.
+     *
+     * Only tracks string boundaries and nesting depth, so it is a single cheap pass.
+     * @return False if there is no plain string "type" member at envelope level.
+     */
+    bool peekEnvelopeType(const std::string &frame, std::string &name) {
+        int depth = 0;
+        for (std::size_t i = 0; i < frame.size(); ++i) {
+            const char c = frame[i];
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                --depth;
+            } else if (c == '"') {
+                const std::size_t start = i + 1;
+                bool escaped = false;
+                for (++i; i < frame.size() && frame[i] != '"'; ++i) {
+                    if (frame[i] == '\\') {
+                        escaped = true;
+                        ++i;
+                    }
+                }
+                if (depth != 1 || escaped || frame.compare(start, i - start, "type") != 0) {
+                    continue;
+                }
+                std::size_t j = i + 1;
+                while (j < frame.size() && std::isspace(static_cast<unsigned char>(frame[j]))) ++j;
+                if (j >= frame.size() || frame[j] != ':') continue;
+                ++j;
+                while (j < frame.size() && std::isspace(static_cast<unsigned char>(frame[j]))) ++j;
+                if (j >= frame.size() || frame[j] != '"') return false;
+                const std::size_t end = frame.find('"', j + 1);
+                if (end == std::string::npos) return false;
+                name.assign(frame, j + 1, end - j - 1);
+                return name.find('\\') == std::string::npos;
+            }
+        }
+        return false;
+    }
+
+    bool findEnvelopeType(const std::string &frame, const WireFormat format, std::string &name) {
+        if (format == WireFormat::JSON) {
+            return peekEnvelopeType(frame, name);
+        }
+        TypePeekHandler handler;
+        json::sax_parse(frame, &handler, inputFormatOf(format));
+        name = std::move(handler.name);
+        return !name.empty();
+    }
+}
+
+namespace utils {
+    bool SaxDecoder::decode(const std::string &frame, const WireFormat format, EventType &type,
+                            dto::ServerMessage &message) {
+        HotMessageHandler handler;
+        if (json::sax_parse(frame, &handler, inputFormatOf(format))) {
+            if (!handler.finish(message)) {
+                return false;
+            }
+            type = handler.type;
+            return true;
+        }
+        if (!handler.needsType()) {
+            return false;
+        }
+
+        std::string name;
+        HotMessageHandler retry;
+        if (!findEnvelopeType(frame, format, name) || !retry.presetType(name)
+            || !json::sax_parse(frame, &retry, inputFormatOf(format))) {
+            return false;
+        }
+        if (!retry.finish(message)) {
+            return false;
+        }
+        type = retry.type;
+        return true;
+    }
+
+    bool SaxDecoder::handles(const EventType type) {
+        Kind kind;
+        return kindOf(type, kind);
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef SAXDECODER_H
+#define SAXDECODER_H
+
+#include <string>
+#include "../dto/GameResponses.h"
+#include "../event/EventType.h"
+#include "../network/WireFormat.h"
+
+namespace utils {
+    /**
+     * @brief Streaming decoder for the high-frequency server messages.
+     *
+     * Position, stats, NPC and player broadcasts make up most of the inbound traffic.
+     * For those the decoder fills the DTO fields directly from nlohmann's SAX events,
+     * without building a JSON DOM and without the per-field key lookups JsonParser does.
+     * JSON text and the binary wire formats go through the same handler.
+     *
+     * It handles only envelopes whose type is one of the hot ones; everything else is left
+     * to the DOM path in parseEvent. Envelopes written with "payload" before "type" (as
+     * serializers with sorted keys do) cost one extra pass over the frame to find the type.
+     */
+    class SaxDecoder {
+    public:
+        /**
+         * @brief Tries to decode a raw frame without building a DOM.
+         * @param frame The raw frame received from the network.
+         * @param format The encoding of the frame.
+         * @param type Receives the resolved event type on success.
+         * @param message Receives the decoded payload on success.
+         * @return True if the frame was decoded, false if the caller must use the DOM path.
+         */
+        static bool decode(const std::string &frame, WireFormat format, EventType &type,
+                           dto::ServerMessage &message);
+
+        /**
+         * @brief Checks whether the streaming path handles the given event type.
+         * @param type The event type.
+         * @return True for the hot message types.
+         */
+        static bool handles(EventType type);
+    };
+}
+
+#endif //SAXDECODER_H
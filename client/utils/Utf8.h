@@ -0,0 +1,45 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <string>
+
+namespace utils {
+    /**
+     * @brief Glyph-level helpers for the UTF-8 map rows.
+     *
+     * Map rows arrive as UTF-8 strings with one code point per tile. Malformed or
+     * truncated sequences count as one byte.
+     */
+    class Utf8 {
+    public:
+        /**
+         * @brief Returns the byte length of the code point starting at the given offset.
+         * @param str The UTF-8 string.
+         * @param pos Byte offset of a lead byte, must be less than str.size().
+         * @return 1 to 4.
+         */
+        static std::size_t glyphLength(const std::string &str, const std::size_t pos) {
+            const auto c = static_cast<unsigned char>(str[pos]);
+            std::size_t length = 1;
+            if ((c & 0xF8) == 0xF0) length = 4;
+            else if ((c & 0xF0) == 0xE0) length = 3;
+            else if ((c & 0xE0) == 0xC0) length = 2;
+            return pos + length > str.size() ? 1 : length;
+        }
+
+        /**
+         * @brief Counts the code points of a string.
+         * @param str The UTF-8 string.
+         * @return The number of glyphs.
+         */
+        static std::size_t glyphCount(const std::string &str) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < str.size(); i += glyphLength(str, i)) {
+                ++count;
+            }
+            return count;
+        }
+    };
+}
+
+#endif //UTF8_H